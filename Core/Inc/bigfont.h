@@ -0,0 +1,30 @@
+#ifndef __BIGFONT_H__
+#define __BIGFONT_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 大号数字字库：0~9 - . % ° C l x，页格式位图 + 比例字宽（数字等宽）。
+ * 字形由 tools/bigfont.py 从 tools/bigfont_src.txt 生成（bigfont_glyphs.inc）。
+ * 绘制时每个字每页一次 SSD1306_BlitColumns；y 为 8 的倍数时就是直接写字节。
+ * 字串按 UTF-8 给（"°" 可直接写），不支持的字符 BigFont_CanDraw 返回 0。 */
+
+typedef enum {
+  BIGFONT_24 = 0,                   /* 24 行高，数字约 11 列 */
+  BIGFONT_32,                       /* 32 行高，数字约 15 列 */
+  BIGFONT_COUNT
+} BigFont_t;
+
+#define BIGFONT_HEIGHT(f)  (24 + 8 * (f))
+
+int     BigFont_TextWidth(BigFont_t f, const char* s);       /* 像素宽（含字间距） */
+uint8_t BigFont_CanDraw(const char* s);                      /* 1=每个字都有 */
+int     BigFont_DrawText(int x, int y, BigFont_t f, const char* s);   /* 返回末尾 x；覆盖字框内原有像素 */
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -7,10 +7,30 @@
 extern "C" {
 #endif
 
-/* 返回给定 Unicode 码点的 16×16 点阵（行优先，共 32 字节）。
- * 找不到则返回 NULL（由 main.c 用“□”占位显示）。 */
+/* 解压后的字形缓存槽数（每槽 38 字节 RAM）；一屏两行中文最多 16 个字 */
+#ifndef FONT16_CACHE_SLOTS
+#define FONT16_CACHE_SLOTS 16
+#endif
+
+typedef struct {
+  uint32_t hits;     /* 缓存命中次数 */
+  uint32_t misses;   /* 需要解压的次数 */
+} Font16_Stats_t;
+
+/* 返回给定 Unicode 码点的 16×16 点阵（SSD1306 页格式，共 32 字节：
+ * 前 16 字节为上半页 16 列，后 16 字节为下半页 16 列，bit0 在上）。
+ * 找不到则返回 NULL（由上层用“□”占位显示）。
+ * 字表按码点排序，二分查找；字库压缩存放，取出的字解压到 RAM 缓存。
+ * 返回的指针指向缓存槽，之后再取 FONT16_CACHE_SLOTS 个别的字才可能被覆盖，
+ * 取到就画，不要长期保存。 */
 const uint8_t* Font16_FindGlyph(uint32_t ucs);
 
+/* 按字库序号取字（序号即码点排序后的位置，由 tools/ui_strings.py 预先算好），
+ * 省掉二分查找；越界返回 NULL。返回值约定同 Font16_FindGlyph。 */
+const uint8_t* Font16_GlyphAt(uint16_t index);
+
+const Font16_Stats_t* Font16_GetStats(void);
+
 #ifdef __cplusplus
 }
 #endif
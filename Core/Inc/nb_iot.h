@@ -13,23 +13,85 @@ extern "C" {
 typedef struct {
   uint8_t inited;   /* AT & PDP & UDP 是否完成 */
   uint8_t opened;   /* UDP socket 是否打开       */
+  uint8_t reg;      /* 网络注册状态（+CEREG 的 stat，1/5=已注册） */
+  uint8_t csq;      /* 信号（+CSQ 的 rssi，99=未知） */
 } NB_State_t;
 
 extern NB_State_t g_nb;
 
-/* 初始化：上电后握手 + 附着 + 设置 APN + 打开 UDP
+/* 收发日志钩子：dir='>' 为发出的 AT 命令/数据，'<' 为模组回的一行（不含 \r\n） */
+typedef void (*NB_LogHook)(char dir, const char* line);
+void NB_SetLogHook(NB_LogHook fn);
+
+/* ---- 非阻塞用法（主循环里用这一组） ----
+ * 命令排队由 AT 引擎逐条执行，NB_Poll() 每圈推进一次：发命令、收回复、判超时、调完成回调，
+ * 不原地等待。模组主动上报的行（URC）也由 NB_Poll() 收下：交给日志钩子，并按前缀更新 g_nb、
+ * 把服务器下发的数据交给收数据钩子。 */
+#ifndef NB_AT_QUEUE
+#define NB_AT_QUEUE  8      /* 最多排队的命令条数 */
+#endif
+#ifndef NB_AT_BUF
+#define NB_AT_BUF    768    /* 排队中的命令文本+数据共用的缓冲（一行截屏约 250 字节） */
+#endif
+#define NB_LINE_MAX  297    /* 单行 UDP 数据上限（不含 \r\n） */
+#ifndef NB_BIN_MAX
+#define NB_BIN_MAX   128    /* 单个二进制 UDP 包上限（命令里按十六进制发，占 2 倍） */
+#endif
+
+/* AT 命令结果（完成回调的 res） */
+#define NB_AT_OK        0
+#define NB_AT_ERROR    (-2)   /* 回复 ERROR */
+#define NB_AT_CME      (-3)   /* 回复 +CME ERROR */
+#define NB_AT_TIMEOUT  (-4)
+#define NB_AT_FULL     (-5)   /* 排队时：队列或缓冲已满 */
+
+typedef void (*NB_AtDone)(int res, void* ctx);
+
+/* 排一条命令：cmd 不含 \r\n（NULL=不发命令，只等回复，如 “+QIOPEN: 1,0”）；
+ * expect 为期望回复的行首（须是常量字符串，引擎只存指针）；超时从命令发出时算起。
+ * data 非空时：收到 “>” 提示后发出 data 并补 0x1A，再等 expect。cmd/data 已拷贝，调用后即可释放。
+ * 返回 0 已排队，NB_AT_FULL 排不下。done 可为 NULL。 */
+int NB_AtQueue(const char* cmd, const char* expect, uint32_t tout_ms,
+               const uint8_t* data, uint16_t data_len, NB_AtDone done, void* ctx);
+uint8_t NB_AtPending(void);        /* 排队中（含正在执行）的命令条数 */
+void    NB_Poll(void);             /* 主循环每圈调用 */
+
+/* 服务器下发的一行数据（+QIURC "recv" 直推或 AT+QIRD 读出），data 以 0 结尾，回调返回后失效 */
+typedef void (*NB_RecvHook)(const char* data, int len);
+void NB_SetRecvHook(NB_RecvHook fn);
+
+/* 原地把 AT 回复的参数部分按逗号切成字段（逗号改成 0，去掉引号，引号内的逗号不切），返回字段数 */
+int NB_SplitFields(char* s, char* f[], int max);
+/* 解析十进制整数（可带符号，前导空格跳过，溢出饱和）：返回数字之后的位置，没有数字返回 NULL */
+const char* NB_ParseInt(const char* s, int32_t* v);
+
+/* 开始初始化（握手 + 附着 + 设置 APN + 打开 UDP），立即返回；各步由 NB_Poll() 推进。
  *  apn  : 例如 "cmiot"（按你的 NB 卡运营商）
  *  ip   : 你的服务器公网 IP 或域名（建议先用 IP）
  *  port : 服务器 UDP 端口
- * 返回：0 成功；<0 失败
- */
+ * 返回：0 已开始；-1 参数错；-5 上一次还没走完。完成后 g_nb.inited=1，结果见 NB_InitResult()。 */
+int NB_InitAsync(const char* apn, const char* ip, uint16_t port);
+int NB_InitResult(void);           /* 1=进行中，0=成功，-2 设置 APN 失败，-3 打开 UDP 失败，-4 排队失败 */
+
+/* 发送一行文本到 UDP（自动在末尾追加 \r\n），立即返回；done(res) 在收到 SEND OK/出错/超时后调用。
+ * 返回：0 已排队；-1 空行；-2 未初始化；NB_AT_FULL 排不下 */
+int NB_SendLineAsync(const char* line, NB_AtDone done, void* ctx);
+
+/* 发送一个二进制 UDP 包（AT+QISENDEX，数据按十六进制写在命令里，不等 “>”），立即返回。
+ * 返回：0 已排队；-1 空包或超过 NB_BIN_MAX；-2 未初始化；NB_AT_FULL 排不下 */
+int NB_SendBinAsync(const uint8_t* p, uint16_t n, NB_AtDone done, void* ctx);
+
+/* ---- 阻塞用法（简单场合）：内部排队后原地调 NB_Poll() 直到做完 ---- */
+
+/* 初始化，返回：0 成功；<0 失败（同 NB_InitResult） */
 int NB_Init(const char* apn, const char* ip, uint16_t port);
 
-/* 发送一行文本到 UDP（自动在末尾追加 \r\n） */
+/* 发送一行文本到 UDP（自动在末尾追加 \r\n），返回：0 成功；-1/-2 同上；-4 发送失败或超时 */
 int NB_SendLine(const char* line);
 
-/* 非阻塞读取一行（\r 或 \n 结束）。
- *  用于调试或读取 URC。超时返回已读长度（可为 0）。
+/* 读取一行（\r 或 \n 结束，不含换行）。数据由 USART1 接收 DMA 在后台收进环形缓冲，
+ *  这里只从缓冲里拼行：有整行立即返回其长度；tout_ms 内没等到整行返回 0（半行留到下次接着拼）。
+ *  AT 引擎（NB_Poll）也从这里取行，用了引擎就不要再直接调。
  */
 int NB_ReadLine(char* out, int max, uint32_t tout_ms);
 
@@ -0,0 +1,28 @@
+#ifndef __OLED_BUS_H
+#define __OLED_BUS_H
+
+#include "ssd1306.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* OLED 传输层：ssd1306.c 只经这几个函数收发，按 SSD1306_BUS 只编译其中一份实现
+ * （oled_bus_spi.c / oled_bus_i2c.c）。data=0 发命令，1 发显存。
+ * 一帧或一串命令包在 Begin/End 之间：SPI 在这里拉低/拉高 CS；I2C 每段自带起止条件，两者为空。 */
+void OLED_Bus_Reset(void);                                   /* 上电复位（SPI 拉 RST；I2C 模块没有 RST 脚，只等上电） */
+void OLED_Bus_Begin(void);
+void OLED_Bus_End(void);
+HAL_StatusTypeDef OLED_Bus_Write(uint8_t data, const uint8_t* p, uint16_t n);     /* 阻塞发送 */
+/* 交给 DMA 后立即返回；p 在发完前须保持不变。发完在中断里调 SSD1306_BusTxDone()，出错调 SSD1306_BusError()。
+ * 返回非 HAL_OK 时没有启动，调用方可改用 OLED_Bus_Write。 */
+HAL_StatusTypeDef OLED_Bus_WriteDMA(uint8_t data, const uint8_t* p, uint16_t n);
+
+/* 由传输层的完成/出错中断调用（实现在 ssd1306.c） */
+void SSD1306_BusTxDone(void);
+void SSD1306_BusError(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
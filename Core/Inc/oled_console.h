@@ -0,0 +1,38 @@
+#ifndef __OLED_CONSOLE_H__
+#define __OLED_CONSOLE_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 整屏滚动控制台：8 行 × 21 字，用 SSD1306 的显示起始行（0x40|n）做硬件滚动。
+ * 新增一行 = 把滚出去的那一页改画成新行（≤128 字节）+ 一条起始行命令，不整屏重画。
+ * 历史行存在紧凑的字节环里（每行只占实际长度），最多 CONSOLE_MAX_LINES 行。 */
+
+#ifndef CONSOLE_MAX_LINES
+#define CONSOLE_MAX_LINES   32      /* 最多保留的行数 */
+#endif
+#ifndef CONSOLE_TEXT_BYTES
+#define CONSOLE_TEXT_BYTES  512     /* 历史文本字节环大小，满了从最旧的行开始丢 */
+#endif
+#define CONSOLE_COLS        21      /* 6x8 字体每行字数 */
+#define CONSOLE_ROWS        8
+#define CONSOLE_PAGE_STEP   4       /* 翻历史每次回退的行数（只重画这几行，其余靠滚动） */
+
+/* 追加文本：'\n' 或超过 21 字自动换行；控制台正在显示且停在最新处时立即画到帧缓冲 */
+void Console_Push(const char* s);
+/* 追加一行，前面加一个方向字符（如 '>' 发送、'<' 接收）；最多占 3 行 */
+void Console_PushTagged(char tag, const char* s);
+
+void    Console_Show(void);         /* 进入控制台页：回到最新，整屏画一次 */
+void    Console_Hide(void);         /* 离开：起始行归 0，之后由调用方整屏重画别的页 */
+uint8_t Console_IsShown(void);
+/* 往回翻 CONSOLE_PAGE_STEP 行；已经到最早的一屏则返回 0（调用方可借此切到下一页） */
+uint8_t Console_PageUp(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,52 @@
+#ifndef __OLED_SNAP_H__
+#define __OLED_SNAP_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 远程截屏：把屏上当前画面（SSD1306 影子缓冲，页格式 1024 字节）压缩后按行发出，
+ * 主机用 tools/oled_snap.py 还原成 PBM/PNG。
+ *
+ * 压缩按“与上一张相比”编码：和上一张相同的字节只记长度，变了的字节给原值或引用本帧前面
+ * 出现过的一段（同一字形/同一行文字重复出现时很省）。关键帧的“上一张”是全黑。令牌：
+ *   0x00..0x3F  n+1 个字节同上一张（关键帧即 0）
+ *   0x40..0x7F  后跟 n+1 个字节原值
+ *   0x80..0xFF  再读 1 字节 b：从本帧往回 ((t&3)<<8|b)+1 处复制 ((t>>2)&0x1F)+3 个字节（可重叠）
+ *
+ * 每行：FB,<序号>,<K|D>,<块号>/<块数>,<起始行>,<CRC16>,<base64>
+ *   D 帧以上一个序号的画面为基准；CRC16（CCITT，初值 0xFFFF）是还原后 1024 字节的校验，
+ *   主机对不上就发 “SNAP K” 要关键帧。起始行是硬件滚动位置（控制台页），主机据此旋转。 */
+
+#ifndef SNAP_CHUNK_BYTES
+#define SNAP_CHUNK_BYTES  144     /* 每行压缩数据字节数（base64 后 192 字符，NB_SendLine 单行上限 297） */
+#endif
+
+/* 发一行（不含 \r\n）；返回 <0 表示发送失败 */
+typedef int (*Snap_LineSink)(const char* line);
+
+/* 收到的一行是否截屏命令（行内含 “SNAP”，“SNAP K”/“SNAPK” 要关键帧）：
+ * 返回 -1=不是，0=普通截屏，1=关键帧 */
+int Snap_ParseCommand(const char* line);
+
+/* 截屏并经 sink 逐行发出（阻塞到发完）。key=1 强制关键帧；没有可用的上一张时自动发关键帧。
+ * 返回压缩后的字节数；<0 为发送失败，此时下一张自动改发关键帧。 */
+int Snap_Send(Snap_LineSink sink, uint8_t key);
+
+/* 分步发送（sink 只是排队、整张一次排不下时用，如 NB 的 AT 队列）：
+ * Snap_Begin 冻结当前画面并算好块数，返回压缩后的字节数；上一张没发完的行作废。
+ * 之后每次 Snap_SendNext 发下一行，返回还剩的行数；sink 返回 <0 时原样返回，这一行留到下次再发。
+ * 最后一行发出后才换成新基准。每发一行要重新编码一遍（只编到那一块为止）。 */
+int     Snap_Begin(uint8_t key);
+int     Snap_SendNext(Snap_LineSink sink);
+uint8_t Snap_Pending(void);        /* 还没发出的行数 */
+
+/* sink 只是排队、真正发送在后面失败时调用：作废基准并丢掉还没发的行，下一张改发关键帧 */
+void Snap_Reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
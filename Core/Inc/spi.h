@@ -35,6 +35,7 @@ extern "C" {
 extern SPI_HandleTypeDef hspi1;
 
 /* USER CODE BEGIN Private defines */
+extern DMA_HandleTypeDef hdma_spi1_tx;
 
 /* USER CODE END Private defines */
 
@@ -2,7 +2,6 @@
 #define __SSD1306_H
 
 #include "stm32f1xx_hal.h"
-#include "stm32_init.h"
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -13,14 +12,92 @@ extern "C" {
 #define SSD1306_HEIGHT   64
 #define SSD1306_PAGES   (SSD1306_HEIGHT/8)
 
+/* 面板后端，编译期选择（-D 覆盖）；帧缓冲、绘图、差分刷新与 UI 代码对所有组合都一样。
+ * 控制器只影响初始化表和每页窗口命令，传输层见 oled_bus.h（oled_bus_spi.c / oled_bus_i2c.c）。 */
+#define SSD1306_CTRL_SSD1306 0      /* 0x21/0x22 列/页窗口，水平寻址 */
+#define SSD1306_CTRL_SH1106  1      /* 只有页寻址：0xB0|页 + 列地址高/低半字节；RAM 132 列 */
+#define SSD1306_BUS_SPI      0      /* SPI1 + CS/DC/RST 引脚 */
+#define SSD1306_BUS_I2C      1      /* 硬件 I2C1（PB8/PB9），控制字节 0x00/0x40 区分命令/显存 */
+
+#ifndef SSD1306_CTRL
+#define SSD1306_CTRL SSD1306_CTRL_SSD1306
+#endif
+
+#ifndef SSD1306_BUS
+#define SSD1306_BUS SSD1306_BUS_SPI
+#endif
+
+/* I2C 7 位地址：SA0 接地 0x3C，接高 0x3D */
+#ifndef SSD1306_I2C_ADDR
+#define SSD1306_I2C_ADDR 0x3C
+#endif
+
+/* 显存列偏移：SH1106 的 132 列 RAM 里可见的 128 列一般从第 2 列开始 */
 #ifndef SSD1306_COL_OFFSET
+#if SSD1306_CTRL == SSD1306_CTRL_SH1106
+#define SSD1306_COL_OFFSET 2
+#else
 #define SSD1306_COL_OFFSET 0
 #endif
+#endif
+
+/* 1=刷新走传输层 DMA（SPI1_TX 或 I2C1_TX，双缓冲，SSD1306_UpdateAsync 立即返回）；0=全部阻塞发送 */
+#ifndef SSD1306_USE_DMA
+#define SSD1306_USE_DMA 1
+#endif
+
+/* 耗时统计用的周期计数（Cortex-M3 DWT）。显示代码本身只依赖帧缓冲、这个计数和 oled_bus.h 的传输层，
+ * 拿到别的平台或主机上编译时换掉这个宏和传输层实现即可，不用动绘图代码。 */
+#ifndef SSD1306_CYCCNT
+#define SSD1306_CYCCNT() (DWT->CYCCNT)
+#endif
+
+/* 1=命令（初始化、窗口、起始行等短串）直接写 SPI 寄存器发送；0=走 HAL_SPI_Transmit。只对 SPI 传输有效 */
+#ifndef SSD1306_USE_LL_CMD
+#define SSD1306_USE_LL_CMD 1
+#endif
+
+/* DMA 刷新完成回调（在 DMA 中断里调用，里面只做置位/计数之类的轻活） */
+typedef void (*SSD1306_FlushCallback)(void);
+
+/* 刷新统计：刷新只发送与屏上内容不同的页/列窗口，这里记录实际发出的量 */
+typedef struct {
+  uint32_t frames;        /* 刷新调用次数 */
+  uint32_t frames_sent;   /* 其中确有数据发出的帧数（画面没变的帧不占 SPI） */
+  uint32_t total_bytes;   /* 累计发送的显存字节数 */
+  uint16_t last_bytes;    /* 最近一帧发送的显存字节数（不含窗口命令） */
+  uint8_t  last_windows;  /* 最近一帧发送的页窗口数（每个窗口另需一串窗口命令：SSD1306 6 字节，SH1106 3 字节） */
+  uint32_t busy_cycles;   /* 累计总线占用时间（DWT 周期，开始发送到发完；回绕后按差值用） */
+} SSD1306_Stats_t;
 
 void SSD1306_Init(void);
-void SSD1306_Update(void);
+/* 发一串命令（SPI 一次 CS/DC，I2C 一次传输）；DMA 刷新进行中会先等它发完 */
+HAL_StatusTypeDef SSD1306_WriteCommands(const uint8_t* cmds, uint16_t len);
+void SSD1306_Update(void);             /* 刷新并等待发送完成（阻塞） */
+void SSD1306_UpdateAsync(void);        /* 把当前画面交给 DMA 后立即返回，可继续画下一帧 */
+uint8_t SSD1306_IsBusy(void);          /* 1=上一帧还在发送 */
+HAL_StatusTypeDef SSD1306_WaitFlush(uint32_t timeout_ms); /* 等待发送完成；HAL_MAX_DELAY=一直等 */
+void SSD1306_SetFlushCallback(SSD1306_FlushCallback cb);
+void SSD1306_Invalidate(void);         /* 下次刷新整屏重发（屏被外部改动/怀疑花屏时用） */
+/* 硬件整屏滚动：屏上第 0 行显示帧缓冲的第 line 行（0..63，按行循环）。
+ * 下次刷新发完显存后生效；帧缓冲坐标始终是物理位置，非 0 时画图需自行换算。 */
+void SSD1306_SetStartLine(uint8_t line);
+uint8_t SSD1306_GetStartLine(void);       /* 最近一次 Set 的值（可能还没发出） */
+uint8_t SSD1306_GetFrontStartLine(void);  /* 与 GetFrontBuffer 那一帧一同发出的起始行 */
+const SSD1306_Stats_t* SSD1306_GetStats(void);
+void SSD1306_ResetStats(void);
 void SSD1306_Fill(uint8_t on);
+uint8_t* SSD1306_GetBuffer(void);      /* 绘图缓冲（页格式，第 p 页第 x 列 = [p*WIDTH+x]） */
+const uint8_t* SSD1306_GetFrontBuffer(void); /* 屏上当前内容（最近一次刷新发出的画面，同样页格式；只在刷新时变） */
 void SSD1306_DrawPixel(uint16_t x, uint16_t y, uint8_t on);
+void SSD1306_FillRect(int x, int y, int w, int h, uint8_t on);   /* on=0 即清除该区域 */
+void SSD1306_DrawHLine(int x, int y, int w, uint8_t on);
+void SSD1306_DrawVLine(int x, int y, int h, uint8_t on);
+void SSD1306_DrawLine(int x0, int y0, int x1, int y1, uint8_t on);
+void SSD1306_BlitColumns(int x, int y, const uint8_t* cols, int w, uint8_t mask); /* 竖排列位图，mask 内覆盖 */
+void SSD1306_OrColumns(int x, int y, const uint8_t* cols, int w);                /* 竖排列位图，只点亮不清除 */
+/* 区域整体左移 n 列，右边空出的 n 列清零；按整页搬，y/h 不是 8 的倍数时向外扩到整页 */
+void SSD1306_ShiftLeft(int x, int y, int w, int h, int n);
 void SSD1306_DrawChar(int x,int y,char c);
 void SSD1306_DrawString(int x,int y,const char* s);
 void SSD1306_DrawCharScaled(int x,int y,char c, uint8_t sx, uint8_t sy, uint8_t bold);
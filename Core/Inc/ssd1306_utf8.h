@@ -2,6 +2,7 @@
 #define __SSD1306_UTF8_H__
 
 #include <stdint.h>
+#include "ui_strings.h"
 
 /* 渲染到现有 ssd1306 帧缓冲（已由 ssd1306.c 暴露 DrawPixel / String 宏族） */
 #ifdef __cplusplus
@@ -23,6 +24,16 @@ void OLED_DrawUTF8_Line_Centered(int y, const char* s);
 /* 将 UTF8 文本切分成两行，宽度不超过屏宽；返回第二行起始指针（可能为 NULL） */
 const char* OLED_UTF8_SplitTwoLines(const char* s);
 
+/* 预编译字符串（tools/ui_strings.txt → ui_strings.h 里的 UI_STR_xxx）：
+ * 不做 UTF-8 解码，宽度与拆行点在生成时算好；字体规则同上 */
+int  OLED_TextWidth(UiStr_t id);
+void OLED_DrawText(int x, int y, UiStr_t id);
+void OLED_DrawText_Centered(int y, UiStr_t id);
+/* 放大居中（参数同 SSD1306_DrawStringCenteredScaled）：欢迎页、自检标题用 */
+void OLED_DrawText_CenteredScaled(int y, UiStr_t id, uint8_t sx, uint8_t sy, uint8_t bold);
+/* 按屏宽拆成两行，分别画在 y1、y2（左对齐） */
+void OLED_DrawText_TwoLines(int y1, int y2, UiStr_t id);
+
 #ifdef __cplusplus
 }
 #endif
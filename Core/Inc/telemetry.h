@@ -0,0 +1,60 @@
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+#include <stdint.h>
+#include "nb_iot.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 遥测打包：采样先攒在缓冲里，攒够条数 / 字节数，或最早一条等够时间，才打成一个 UDP 包发出，
+ * 省下每条一次的 AT+QISEND 往返和射频唤醒。发送失败的包隔 TLM_RETRY_MS 原样重发（序号不变，
+ * 服务器可去重）；重发前又攒满一包时丢掉旧包。
+ *
+ * 包是二进制的（AT+QISENDEX 按十六进制交给模组，空中仍是原始字节），主机用 tools/tlm_decode.py 解。
+ * uv=无符号 varint（LEB128，每字节低 7 位、最高位=后面还有），sv=zigzag 后的 uv。
+ *   包头：<版本 TLM_FMT_VERSION> <uv 包序号> <uv 首条时刻 s>
+ *   每条：<标志> <uv 距上一条秒数> <sv ΔVDD mV> [<sv Δ温度> <sv Δ湿度>] [<sv Δ照度 lx>]
+ *     标志 bit0=有温湿度，bit1=有照度，其余位为 0（解码遇到未知位即报错）；
+ *     Δ 都是相对本包里上一次出现的同一量（包内第一次相对 0），首条的“上一条”是包头时刻。
+ *   常见一条 6~7 字节（10 秒一条、读数小幅变化）。 */
+
+#define TLM_FMT_VERSION   1
+
+#ifndef TLM_MAX_SAMPLES
+#define TLM_MAX_SAMPLES   6          /* 每包最多条数 */
+#endif
+#ifndef TLM_MAX_AGE_MS
+#define TLM_MAX_AGE_MS    60000u     /* 首条最多等这么久就发 */
+#endif
+#ifndef TLM_MAX_BYTES
+#define TLM_MAX_BYTES     NB_BIN_MAX /* 每包最多字节数（不能超过 NB 单包上限） */
+#endif
+#ifndef TLM_RETRY_MS
+#define TLM_RETRY_MS      10000u     /* 发送失败/NB 未就绪时的重试间隔 */
+#endif
+
+#define TLM_HAS_DHT  0x01            /* temp/humi 有效 */
+#define TLM_HAS_LUX  0x02            /* lux 有效 */
+
+typedef struct {
+  uint32_t t_ms;                     /* 采样时刻（HAL_GetTick） */
+  uint16_t vdd_mv;
+  uint8_t  temp;                     /* °C */
+  uint8_t  humi;                     /* % */
+  uint32_t lux;                      /* lx（四舍五入） */
+  uint8_t  flags;                    /* TLM_HAS_xxx */
+} Tlm_Sample_t;
+
+/* 记一条；这一包放不下时先封包。返回 0，<0 为被丢弃（上一包还在发送途中，新包封不了） */
+int  Tlm_Add(const Tlm_Sample_t* s);
+/* 主循环每圈调用：到时间的包封好发出、失败的包重发 */
+void Tlm_Poll(uint32_t now_ms);
+
+uint32_t Tlm_Dropped(void);          /* 因来不及发送而丢掉的条数 */
+
+#ifdef __cplusplus
+}
+#endif
+#endif
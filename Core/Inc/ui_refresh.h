@@ -0,0 +1,51 @@
+#ifndef __UI_REFRESH_H__
+#define __UI_REFRESH_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 事件驱动的刷新调度：数据有变化的地方（按键、传感器、电机、NB……）调 UI_Post 置一个事件位，
+ * 主循环每圈问一次 UI_RefreshDue()：有事件且离上一帧已满 1000/UI_MAX_FPS ms 才渲染并刷屏；
+ * 没有事件就不渲染、SPI 也不动。UI_IDLE_MS 是无事件时的兜底间隔（值没变的控件照样不重画）。
+ * 只在主循环上下文里调用。 */
+
+#ifndef UI_MAX_FPS
+#define UI_MAX_FPS    25u           /* 帧率上限：两帧至少间隔 1000/UI_MAX_FPS ms */
+#endif
+#ifndef UI_IDLE_MS
+#define UI_IDLE_MS    1000u         /* 无事件时至多隔这么久刷新一次；0=只靠事件 */
+#endif
+
+#define UI_EV_INPUT   0x01u         /* 按键/翻页 */
+#define UI_EV_SENSOR  0x02u         /* 温湿度、光照读数或状态变了 */
+#define UI_EV_POWER   0x04u         /* 供电电压/低压状态变了 */
+#define UI_EV_MOTOR   0x08u         /* 电机占空比/模式变了 */
+#define UI_EV_ALARM   0x10u         /* 告警状态变了 */
+#define UI_EV_NB      0x20u         /* NB 上报文本/收发日志有新内容 */
+#define UI_EV_ANIM    0x40u         /* 动画走一帧（如风扇） */
+#define UI_EV_IDLE    0x80u         /* 兜底刷新（UI_IDLE_MS 到了） */
+
+typedef struct {
+  uint32_t frames;                  /* 累计渲染帧数 */
+  uint32_t events;                  /* 累计 UI_Post 次数 */
+  uint16_t fps_x10;                 /* 最近 1 秒帧率 ×10 */
+  uint16_t spi_permille;            /* 最近 1 秒 SPI 占用率（‰） */
+  uint32_t spi_busy_us;             /* 最近 1 秒 SPI 占用时间（微秒） */
+  uint16_t latency_ms;              /* 最近 1 秒内事件到开始渲染的最大延迟 */
+} UI_RefreshStats_t;
+
+void     UI_Post(uint32_t ev);
+/* 该不该刷新：返回本帧要处理的事件位并清掉（0=这圈不刷）。返回非 0 时调用方渲染、
+ * SSD1306_UpdateAsync，然后调 UI_RefreshDone */
+uint32_t UI_RefreshDue(uint32_t now_ms);
+void     UI_RefreshDone(uint32_t now_ms);
+
+const UI_RefreshStats_t* UI_GetRefreshStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,19 @@
+/* 由 tools/ui_sprites.py 从 tools/ui_sprites.txt 生成，勿手改 */
+#ifndef UI_SPRITES_H
+#define UI_SPRITES_H
+
+#include "ui_widget.h"
+
+#define UI_SPR_SPEAKER_W 11
+#define UI_SPR_SPEAKER_N 1
+extern const UI_Sprite_t UI_SPR_SPEAKER;
+
+#define UI_SPR_FAN_W 8
+#define UI_SPR_FAN_N 4
+extern const UI_Sprite_t UI_SPR_FAN;
+
+#define UI_SPR_MANUAL_W 8
+#define UI_SPR_MANUAL_N 1
+extern const UI_Sprite_t UI_SPR_MANUAL;
+
+#endif
@@ -0,0 +1,17 @@
+/* 由 tools/ui_strings.py 从 tools/ui_strings.txt 生成，勿手改 */
+#ifndef UI_STRINGS_H
+#define UI_STRINGS_H
+
+typedef enum {
+  UI_STR_HEADER,              /* Hello STM32 */
+  UI_STR_HW_CHECK,            /* Hardware Check */
+  UI_STR_WELCOME,             /* Welcome to */
+  UI_STR_PRODUCT,             /* AI Farmland Terminal */
+  UI_STR_HELLO_CN,            /* 你好 */
+  UI_STR_CHINESE,             /* 中文 */
+  UI_STR_TEMP_HUMI_CN,        /* 温湿 */
+  UI_STR_BLUETOOTH_CN,        /* 蓝牙 */
+  UI_STR_COUNT
+} UiStr_t;
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef __UI_WIDGET_H__
+#define __UI_WIDGET_H__
+
+#include "stm32f1xx_hal.h"
+#include <stdint.h>
+#include "ui_strings.h"
+#include "bigfont.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 保留模式的小控件层：每个控件记住上次显示的内容，值没变就不格式化、不重画；
+ * 变了才清掉自己的矩形区域再画。帧缓冲不再每帧清屏，SSD1306_UpdateAsync
+ * 的逐页比较自然只会把这些小区域发出去。
+ *
+ * 一页 = 一张控件指针表（公共的标题/图标/底栏也直接放进每页的表里）。
+ * 换页时调 UI_Show()：清屏并让整页控件重画；之后每帧调 UI_Render()。 */
+
+#define UI_TEXT_MAX   44            /* 文本缓存：单行 21 字，两行框 42 字 */
+
+/* 页面模板：每页的固定内容（UI_CHROME 控件：标题、固定标签）第一次显示时单独画一次，
+ * 按显存页记下非零列区间存进共享字节池；之后换到这页直接拷模板，只重画动态控件。
+ * 池或页数不够的页照常整页渲染。0=关闭（UI_CHROME 就当普通标签）。 */
+#ifndef UI_PAGE_CACHE
+#define UI_PAGE_CACHE      1
+#endif
+#ifndef UI_TPL_PAGES
+#define UI_TPL_PAGES       10       /* 最多缓存的页数 */
+#endif
+#ifndef UI_TPL_POOL_BYTES
+#define UI_TPL_POOL_BYTES  768      /* 所有页模板共用的字节池 */
+#endif
+
+typedef enum {
+  UI_W_TEXT = 0,                    /* 文本/数字：UI_SetText / UI_SetTextId / UI_SetNumber */
+  UI_W_TEXT2,                       /* 两行文本框，每行 21 字居中，超出裁掉 */
+  UI_W_ICON,                        /* 图标：state=0 隐藏，否则调 draw(x,y,state) */
+  UI_W_SPRITE,                      /* 预渲染图标：state=0 隐藏，否则显示第 state-1 帧 */
+  UI_W_CHART,                       /* 趋势曲线：UI_ChartPush 追加样本，每个样本占一列 */
+} UI_Kind_t;
+
+typedef enum { UI_ALIGN_LEFT = 0, UI_ALIGN_CENTER = 1 } UI_Align_t;
+
+typedef void (*UI_IconFn)(int x, int y, int32_t state);
+
+/* 预渲染图标：8 行高，每帧 w 列、每列 1 字节（显存页格式），帧依次相连。
+ * 数据由 tools/ui_sprites.py 从字符画生成（ui_sprites.h / ui_sprites.inc）。 */
+typedef struct {
+  uint8_t        w;
+  uint8_t        frames;
+  const uint8_t* cols;              /* frames * w 字节 */
+} UI_Sprite_t;
+
+/* 曲线数据：环形缓存，容量 = 控件宽度（每列一个样本）。min/max 随样本进出增量维护；
+ * 纵轴 [lo,hi] 只在数据超出或明显收窄时才重算，重算了整块重画，否则每个新样本
+ * 只把区域左移一列、画最右一列。 */
+typedef struct {
+  int16_t* buf;
+  uint8_t  cap;                     /* 样本容量（= 控件宽度） */
+  uint8_t  count;
+  uint8_t  head;                    /* 下一个写入位置 */
+  uint8_t  pending;                 /* 上次画完后新来的样本数 */
+  int16_t  min_span;                /* 纵轴最小跨度（数据平时纵轴不至于把噪声放大满屏） */
+  int16_t  min, max;                /* 缓存内样本的最小/最大 */
+  int16_t  lo, hi;                  /* 当前纵轴范围 */
+} UI_Chart_t;
+
+/* 定义一条曲线的数据（静态）：UI_CHART_DEF(c_temp, 128, 4); */
+#define UI_CHART_DEF(name_, cap_, span_) \
+  static int16_t name_##_buf[(cap_)]; \
+  static UI_Chart_t name_ = { .buf = name_##_buf, .cap = (cap_), .min_span = (span_) }
+
+typedef struct {
+  uint8_t     kind;
+  uint8_t     align;
+  uint8_t     chrome;               /* 1=页面固定内容，内容不可再改（进页模板） */
+  uint8_t     font;                 /* 0=6x8；否则 BigFont_t+1，数字用大字，其它文本仍用 6x8 竖直居中 */
+  uint8_t     x, y, w, h;           /* 控件占用的矩形，重画前整块清掉 */
+  /* 数字格式：prefix + 值（至少 width 位，右对齐补空格；decimals 位小数）+ suffix */
+  const char* prefix;
+  const char* suffix;
+  uint8_t     width;
+  uint8_t     decimals;
+  UI_IconFn   draw;
+  const UI_Sprite_t* sprite;
+  UI_Chart_t*        chart;
+  /* 以下为运行时缓存 */
+  uint8_t     dirty;                /* 1=整块重画；曲线另有 2=只画新样本列 */
+  uint8_t     has_value;            /* 1=text 是由 value 格式化来的 */
+  int16_t     str_id;               /* >=0：显示预编译字符串 UiStr_t */
+  int32_t     value;                /* 数字或图标状态 */
+  char        text[UI_TEXT_MAX];
+} UI_Widget_t;
+
+/* 静态定义用的初始化宏（区域按像素给） */
+#define UI_LABEL(x_, y_, w_, align_, s_) \
+  { .kind = UI_W_TEXT, .align = (align_), .x = (x_), .y = (y_), .w = (w_), .h = 8, \
+    .dirty = 1, .str_id = -1, .text = s_ }
+#define UI_LABEL_ID(x_, y_, w_, align_, id_) \
+  { .kind = UI_W_TEXT, .align = (align_), .x = (x_), .y = (y_), .w = (w_), .h = 8, \
+    .dirty = 1, .str_id = (id_) }
+/* 固定内容（页标题等）：与 UI_LABEL/UI_LABEL_ID 相同，但画进页模板，之后不再 UI_Set* */
+#define UI_CHROME(x_, y_, w_, align_, s_) \
+  { .kind = UI_W_TEXT, .align = (align_), .chrome = 1, .x = (x_), .y = (y_), .w = (w_), .h = 8, \
+    .dirty = 1, .str_id = -1, .text = s_ }
+#define UI_CHROME_ID(x_, y_, w_, align_, id_) \
+  { .kind = UI_W_TEXT, .align = (align_), .chrome = 1, .x = (x_), .y = (y_), .w = (w_), .h = 8, \
+    .dirty = 1, .str_id = (id_) }
+#define UI_NUMBER(x_, y_, w_, align_, pre_, width_, dec_, suf_) \
+  { .kind = UI_W_TEXT, .align = (align_), .x = (x_), .y = (y_), .w = (w_), .h = 8, \
+    .prefix = (pre_), .suffix = (suf_), .width = (width_), .decimals = (dec_), \
+    .dirty = 1, .str_id = -1 }
+/* 大字读数：格式同 UI_NUMBER，区域高度为字高；前后缀只能用大字库里有的字（如 "°C" "%" "lx"） */
+#define UI_BIGNUMBER(x_, y_, w_, align_, pre_, width_, dec_, suf_, font_) \
+  { .kind = UI_W_TEXT, .align = (align_), .font = (font_) + 1, .x = (x_), .y = (y_), .w = (w_), \
+    .h = BIGFONT_HEIGHT(font_), .prefix = (pre_), .suffix = (suf_), .width = (width_), .decimals = (dec_), \
+    .dirty = 1, .str_id = -1 }
+#define UI_TEXTBOX2(y_) \
+  { .kind = UI_W_TEXT2, .align = UI_ALIGN_CENTER, .x = 0, .y = (y_), .w = 128, .h = 16, .dirty = 1, .str_id = -1 }
+#define UI_ICON(x_, y_, w_, h_, fn_) \
+  { .kind = UI_W_ICON, .x = (x_), .y = (y_), .w = (w_), .h = (h_), .draw = (fn_), \
+    .dirty = 1, .str_id = -1 }
+/* name 为 ui_sprites.h 里的图标名，如 UI_SPRITE(96, 0, FAN)；y 取 8 的倍数时换帧只写 w 个字节 */
+#define UI_SPRITE(x_, y_, name_) \
+  { .kind = UI_W_SPRITE, .x = (x_), .y = (y_), .w = UI_SPR_##name_##_W, .h = 8, \
+    .sprite = &UI_SPR_##name_, .dirty = 1, .str_id = -1 }
+
+/* 曲线区域：y/h 取 8 的倍数（左移按整页搬），w 须等于 UI_CHART_DEF 的容量 */
+#define UI_CHART(x_, y_, w_, h_, chart_) \
+  { .kind = UI_W_CHART, .x = (x_), .y = (y_), .w = (w_), .h = (h_), .chart = &(chart_), \
+    .dirty = 1, .str_id = -1 }
+
+typedef struct {
+  UI_Widget_t* const* items;
+  uint8_t             count;
+} UI_Page_t;
+
+#define UI_PAGE(arr) { (arr), (uint8_t)(sizeof(arr) / sizeof((arr)[0])) }
+
+typedef struct {
+  uint32_t last_cycles;             /* 上一次 UI_Render 的 CPU 周期（DWT） */
+  uint32_t max_cycles;
+  uint8_t  last_drawn;              /* 上一次实际重画的控件数 */
+  uint32_t show_cycles;             /* 上一次 UI_Show（换页）的 CPU 周期，含清屏/拷模板/渲染 */
+  uint32_t show_max;
+  uint8_t  tpl_pages;               /* 已建模板的页数 */
+  uint16_t tpl_bytes;               /* 模板池已用字节 */
+} UI_Stats_t;
+
+/* 设置内容；与当前显示相同则什么都不做 */
+void UI_SetText(UI_Widget_t* w, const char* s);
+void UI_SetTextId(UI_Widget_t* w, UiStr_t id);
+void UI_SetNumber(UI_Widget_t* w, int32_t v);
+void UI_SetIcon(UI_Widget_t* w, int32_t state);
+void UI_Animate(UI_Widget_t* w, uint8_t on);  /* 预渲染图标：on=1 走到下一帧（循环），on=0 隐藏 */
+void UI_Invalidate(UI_Widget_t* w);
+void UI_ChartPush(UI_Widget_t* w, int16_t v); /* 追加一个样本，下次渲染时只画新列 */
+
+void    UI_Show(const UI_Page_t* pg);       /* 清屏 + 整页标脏 + 渲染（有模板则拷模板，只画动态控件） */
+uint8_t UI_Render(const UI_Page_t* pg);     /* 只重画脏控件，返回重画个数 */
+
+const UI_Stats_t* UI_GetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
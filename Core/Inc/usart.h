@@ -35,12 +35,21 @@ extern "C" {
 extern UART_HandleTypeDef huart1;
 
 /* USER CODE BEGIN Private defines */
+extern DMA_HandleTypeDef hdma_usart1_rx;
+
+/* USART1 接收环形缓冲大小（2 的幂）；9600 波特下 512 字节约够主循环 0.5s 不来取 */
+#ifndef UART1_RX_RING
+#define UART1_RX_RING 512u
+#endif
 
 /* USER CODE END Private defines */
 
 void MX_USART1_UART_Init(void);
 
 /* USER CODE BEGIN Prototypes */
+void     UART1_RxStart(void);       /* 开始循环 DMA 接收（MX_USART1_UART_Init 里已调用） */
+uint16_t UART1_RxAvailable(void);   /* 环形缓冲里未读的字节数 */
+int      UART1_RxGetc(void);        /* 取一个字节；没有数据立即返回 -1 */
 
 /* USER CODE END Prototypes */
 
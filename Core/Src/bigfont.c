@@ -0,0 +1,65 @@
+#include "bigfont.h"
+#include "ssd1306.h"
+
+typedef struct {
+  uint16_t off;                     /* 在位图里的起点 */
+  uint8_t  w;                       /* 列数（= 显示宽度，不含字间距） */
+} BigGlyph_t;
+
+typedef struct {
+  const uint8_t*    bmp;
+  const BigGlyph_t* glyphs;
+  uint8_t           height;
+  uint8_t           gap;            /* 字间距 */
+} BigFontDesc_t;
+
+#include "bigfont_glyphs.inc"
+
+typedef char bigfont_count_check[(sizeof(BIGFONTS) / sizeof(BIGFONTS[0]) == BIGFONT_COUNT) ? 1 : -1];
+
+/* 取下一个字的 1 字节编码：ASCII 原样，UTF-8 的 “°”（C2 B0）取 0xB0，其它多字节字符给 0 */
+static uint8_t bf_next(const char** ps){
+  const uint8_t* p = (const uint8_t*)*ps;
+  uint8_t c = *p++;
+  if (c >= 0x80){
+    uint8_t c2 = *p;
+    if (c == 0xC2 && c2 == 0xB0){ p++; c = 0xB0; }
+    else { while ((*p & 0xC0) == 0x80) p++; c = 0; }
+  }
+  *ps = (const char*)p;
+  return c;
+}
+
+int BigFont_TextWidth(BigFont_t f, const char* s){
+  if (!s || f >= BIGFONT_COUNT) return 0;
+  const BigFontDesc_t* d = &BIGFONTS[f];
+  int w = 0;
+  while (*s){
+    uint8_t i = BIGFONT_INDEX[bf_next(&s)];
+    if (i == 0xFF) continue;
+    w += d->glyphs[i].w + d->gap;
+  }
+  return w ? w - d->gap : 0;
+}
+
+uint8_t BigFont_CanDraw(const char* s){
+  if (!s || !*s) return 0;
+  while (*s) if (BIGFONT_INDEX[bf_next(&s)] == 0xFF) return 0;
+  return 1;
+}
+
+int BigFont_DrawText(int x, int y, BigFont_t f, const char* s){
+  if (!s || f >= BIGFONT_COUNT) return x;
+  const BigFontDesc_t* d = &BIGFONTS[f];
+  uint8_t pages = d->height / 8;
+  while (*s && x < SSD1306_WIDTH){
+    uint8_t i = BIGFONT_INDEX[bf_next(&s)];
+    if (i == 0xFF) continue;
+    const BigGlyph_t* g = &d->glyphs[i];
+    const uint8_t* col = d->bmp + g->off;
+    for (uint8_t p = 0; p < pages; ++p, col += g->w)
+      SSD1306_BlitColumns(x, y + 8 * p, col, g->w, 0xFF);
+    x += g->w + d->gap;
+  }
+  return x;
+}
@@ -3,97 +3,110 @@
 #include <stdint.h>
 
 /* 说明：
- * - 每个汉字为 16x16 单色点阵，共 16 行；每行 16 位 → 2 字节；总 32 字节。
- * - 位序：高位在左（0x80 -> 最左像素）。1=点亮，0=熄灭。
- * - 表中仅示例收录少数字（“你 好 中 文 温 湿 蓝 牙”），其余未收录的字会由 main.c 显示为“□”。
- * - 你可用点阵工具或脚本导出 16x16 位图，把 32 字节贴到下方表里即可。
+ * - 每个汉字为 16x16 单色点阵，按 SSD1306 页格式使用，共 32 字节：
+ *   前 16 字节是上半页（第 0~7 行）的 16 列，后 16 字节是下半页（第 8~15 行）的 16 列，
+ *   每字节 bit0 在最上面。绘制时整字节 OR 进显存（y 对齐 8 时就是 32 次字节或）。
+ * - 表中仅示例收录少数字（“你 好 中 文 温 湿 蓝 牙”），其余未收录的字会由上层显示为“□”。
+ *
+ * 存储：码点索引 FONT16_CODES[] 按码点从小到大排列（查找用二分，O(log n)），
+ * 第 i 个字的压缩点阵为 FONT16_Z[FONT16_OFFS[i] .. FONT16_OFFS[i+1])。
+ * 这几张表放在 font16_glyphs.inc（主机基准可用 FONT16_GLYPHS_INC 换成整表），由 tools/font16_convert.py 生成：
+ * 它能读行优先的 C 点阵表（高位在左）或 16px BDF 字体，排序、转置、压缩后输出；
+ * 追加新字时把已有的 .inc 和新字一起喂给工具即可合并，不要手改 .inc。
+ *
+ * 压缩格式（每字独立）：半页内每列先与左边一列异或（笔画连续处变成 0），
+ * 然后是 token 流：token 高 4 位 = 连续 0 字节个数，低 4 位 = 紧跟的原样字节个数，
+ * 直到凑满 32 字节。汉字笔画规整，一般能压到原来的六七成。
+ *
+ * 解压结果放在 RAM 里的小 LRU 缓存（FONT16_CACHE_SLOTS 个字），
+ * 同一屏上反复出现的字只解一次，翻页回来也多半还在缓存里。
  */
 
-/* ✅ 关键修复：把 bmp 改为指针类型，便于用外部数组名初始化 */
-typedef struct { uint32_t ucs; const uint8_t *bmp; } G16;
+#ifndef FONT16_GLYPHS_INC
+#define FONT16_GLYPHS_INC "font16_glyphs.inc"
+#endif
+#include FONT16_GLYPHS_INC
 
-/* ===== 示例字形（简化笔画，仅供演示） ===== */
+#define FONT16_COUNT (sizeof(FONT16_CODES)/sizeof(FONT16_CODES[0]))
 
-/* “你” U+4F60（示意） */
-static const uint8_t G_4F60[32] = {
-  0x00,0x10, 0x00,0x10, 0x7F,0xFE, 0x00,0x10,
-  0x00,0x10, 0x1F,0xF0, 0x00,0x20, 0x00,0x40,
-  0x7F,0xFE, 0x00,0x80, 0x01,0x00, 0x06,0x00,
-  0x18,0x00, 0x60,0x00, 0x01,0x80, 0x00,0x60
-};
-/* “好” U+597D */
-static const uint8_t G_597D[32] = {
-  0x00,0x08, 0x3F,0xFC, 0x20,0x08, 0x20,0x08,
-  0x3F,0xF8, 0x20,0x08, 0x20,0x08, 0x3F,0xF8,
-  0x04,0x00, 0x04,0x00, 0x24,0x00, 0x24,0x00,
-  0x44,0x00, 0x84,0x00, 0x04,0x00, 0x04,0x00
-};
-/* “中” U+4E2D */
-static const uint8_t G_4E2D[32] = {
-  0x00,0x00, 0x01,0x00, 0x01,0x00, 0x7F,0xFE,
-  0x41,0x02, 0x41,0x02, 0x41,0x02, 0x7F,0xFE,
-  0x41,0x02, 0x41,0x02, 0x41,0x02, 0x7F,0xFE,
-  0x01,0x00, 0x01,0x00, 0x00,0x00, 0x00,0x00
-};
-/* “文” U+6587 */
-static const uint8_t G_6587[32] = {
-  0x00,0x00, 0x00,0x80, 0x40,0x80, 0x20,0x80,
-  0x10,0x80, 0x0F,0xFE, 0x00,0x80, 0x01,0x80,
-  0x02,0x80, 0x0C,0x80, 0x30,0x80, 0xC0,0x80,
-  0x00,0x80, 0x00,0x80, 0x00,0x80, 0x00,0x00
-};
-/* “温” U+6E29（示意） */
-static const uint8_t G_6E29[32] = {
-  0x00,0x00, 0x00,0x20, 0x7F,0xFE, 0x02,0x20,
-  0x12,0x20, 0x0A,0x20, 0x7F,0xFE, 0x02,0x20,
-  0x12,0x20, 0x0A,0x20, 0x7F,0xFE, 0x00,0x00,
-  0x1F,0xF8, 0x10,0x08, 0x1F,0xF8, 0x10,0x08
-};
-/* “湿” U+6E7F（示意） */
-static const uint8_t G_6E7F[32] = {
-  0x00,0x20, 0x7F,0xFE, 0x02,0x20, 0x02,0x20,
-  0x3F,0xF0, 0x22,0x10, 0x3F,0xF0, 0x22,0x10,
-  0x3F,0xF0, 0x00,0x00, 0x1F,0xF8, 0x10,0x08,
-  0x1F,0xF8, 0x10,0x08, 0x1F,0xF8, 0x10,0x08
-};
-/* “蓝” U+84DD（示意） */
-static const uint8_t G_84DD[32] = {
-  0x00,0x40, 0x7F,0xFE, 0x04,0x40, 0x04,0x40,
-  0x3F,0xF8, 0x24,0x48, 0x3F,0xF8, 0x24,0x48,
-  0x3F,0xF8, 0x00,0x00, 0x7F,0xFE, 0x01,0x00,
-  0x11,0x10, 0x0E,0xE0, 0x00,0x00, 0x00,0x00
-};
-/* “牙” U+7259（示意） */
-static const uint8_t G_7259[32] = {
-  0x00,0x00, 0x7F,0xFE, 0x01,0x00, 0x01,0x00,
-  0x3F,0xFC, 0x21,0x04, 0x21,0x04, 0x3F,0xFC,
-  0x01,0x00, 0x01,0x00, 0x7F,0xFE, 0x00,0x00,
-  0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00
-};
+/* 索引与偏移表长度不一致时编译报错（数组长度为负） */
+typedef char font16_tables_match[(FONT16_COUNT + 1 == sizeof(FONT16_OFFS)/sizeof(FONT16_OFFS[0])) ? 1 : -1];
 
-/* 可继续在此追加更多字：
- * 例如：
- * static const uint8_t G_53D1[32] = { /* “发” * / ... };
- * static const uint8_t G_9001[32] = { /* “送” * / ... };
- */
+typedef struct {
+  uint32_t used;       /* 最近一次命中的时间戳；0 = 空槽 */
+  uint16_t code;
+  uint8_t  bmp[32];
+} Font16_Slot_t;
 
-static const G16 g_table[] = {
-  {0x4F60, G_4F60}, /* 你 */
-  {0x597D, G_597D}, /* 好 */
-  {0x4E2D, G_4E2D}, /* 中 */
-  {0x6587, G_6587}, /* 文 */
-  {0x6E29, G_6E29}, /* 温 */
-  {0x6E7F, G_6E7F}, /* 湿 */
-  {0x84DD, G_84DD}, /* 蓝 */
-  {0x7259, G_7259}, /* 牙 */
-  /* 在此继续追加 … */
-};
+static Font16_Slot_t  s_cache[FONT16_CACHE_SLOTS];
+static uint32_t       s_tick;
+static Font16_Stats_t s_stats;
 
-const uint8_t* Font16_FindGlyph(uint32_t ucs)
+static void font16_unpack(const uint8_t* z, uint8_t out[32])
+{
+  uint8_t i = 0;
+  while (i < 32){
+    uint8_t t = *z++;
+    for (uint8_t n = t >> 4;   n && i < 32; --n) out[i++] = 0;
+    for (uint8_t n = t & 0x0F; n && i < 32; --n) out[i++] = *z++;
+  }
+  for (uint8_t c = 1; c < 16; ++c){      /* 撤销列间异或 */
+    out[c]      ^= out[c - 1];
+    out[16 + c] ^= out[16 + c - 1];
+  }
+}
+
+static int font16_index(uint16_t key)
+{
+  /* 二分查找：[lo, hi) */
+  unsigned lo = 0, hi = FONT16_COUNT;
+  while (lo < hi){
+    unsigned mid = (lo + hi) >> 1;
+    uint16_t c = FONT16_CODES[mid];
+    if (c == key) return (int)mid;
+    if (c < key) lo = mid + 1; else hi = mid;
+  }
+  return -1;
+}
+
+/* 取第 i 个字（i<0 表示还没查索引，缓存未命中时再二分） */
+static const uint8_t* font16_get(uint16_t key, int i)
 {
-  /* 简单线性查找（表不大时足够；后续可换成二分或哈希） */
-  for (unsigned i = 0; i < sizeof(g_table)/sizeof(g_table[0]); ++i){
-    if (g_table[i].ucs == ucs) return g_table[i].bmp;
+  /* 先查缓存，顺便记下最久没用的槽（空槽 used=0 最先被选中） */
+  Font16_Slot_t* victim = &s_cache[0];
+  for (unsigned k = 0; k < FONT16_CACHE_SLOTS; ++k){
+    Font16_Slot_t* sl = &s_cache[k];
+    if (sl->used && sl->code == key){
+      sl->used = ++s_tick;
+      s_stats.hits++;
+      return sl->bmp;
+    }
+    if (sl->used < victim->used) victim = sl;
   }
-  return NULL; /* 交给上层用“□”占位 */
+
+  if (i < 0) i = font16_index(key);
+  if (i < 0) return NULL;                /* 交给上层用“□”占位 */
+
+  s_stats.misses++;
+  font16_unpack(&FONT16_Z[FONT16_OFFS[i]], victim->bmp);
+  victim->code = key;
+  victim->used = ++s_tick;
+  return victim->bmp;
+}
+
+const uint8_t* Font16_FindGlyph(uint32_t ucs)
+{
+  if (ucs > 0xFFFFu) return NULL;
+  return font16_get((uint16_t)ucs, -1);
+}
+
+const uint8_t* Font16_GlyphAt(uint16_t index)
+{
+  if (index >= FONT16_COUNT) return NULL;
+  return font16_get(FONT16_CODES[index], (int)index);
+}
+
+const Font16_Stats_t* Font16_GetStats(void)
+{
+  return &s_stats;
 }
@@ -1,9 +1,17 @@
 #include "main.h"
 #include "gpio.h"
 #include "spi.h"
+#include "i2c.h"
 #include "soft_i2c.h"
 
 #include "ssd1306.h"
+#include "ssd1306_utf8.h"
+#include "ui_widget.h"
+#include "ui_sprites.h"
+#include "ui_refresh.h"
+#include "bigfont.h"
+#include "oled_console.h"
+#include "oled_snap.h"
 #include "DHT11.h"
 #include "adc.h"
 #include "tim.h"
@@ -11,15 +19,20 @@
 #include <string.h>
 #include "usart.h"
 #include "nb_iot.h"
+#include "telemetry.h"
 #include "bh1750.h"
 #include "stm32_init.h"   // Read_VDDA_mV()
 
 /* =============================================================================
- *                      配置与说明（保持页面顺序：ENV->LUX->NB）
+ *                      配置与说明（保持页面顺序：ENV->LUX->NB->CON）
  * =============================================================================
  * - 开机默认仍在 ENV 页（不强制跳到 NB 页）
+ * - 趋势页：温度、湿度曲线跟在 ENV 后，光照曲线跟在 LUX 后；每 CHART_SAMPLE_MS 采一点，
+ *   一屏 128 点（默认 1 分钟一点，约 2 小时）
  * - NB 页：两行窗口显示最近一次上报/回显的文本（不加省略号）
- * - 每 10 秒主动上报一行状态到服务器（可通过宏关闭）
+ * - CON 页：NB/AT 收发日志滚动控制台（硬件滚动）；在此页按 PB10 往回翻历史，
+ *   翻到最早一屏后再按才切到下一页
+ * - 每 10 秒采一条状态，攒够 6 条或 60 秒打成一个 UDP 包上报（可通过宏关闭，见 telemetry.h）
  * - 电机：PB11 短按=进入/留在手动并启停；长按=退出手动回自动
  * - 顶部右侧：喇叭（告警），左 10px 风扇（占空比>0 时转），再左 10px “M”手动指示
  * - PWM 使用 TIM2_CH1@PA0（需在 CubeMX 里启用）
@@ -28,13 +41,15 @@
 #define WELCOME_SHOW_MS       5000u
 #define SELFTEST_SHOW_MS      5000u
 #define OLED_VISUAL_TEST_MS   0u
+#define OLED_BENCH_ENABLE     0      /* 1=自检后显示一屏绘图耗时（DWT 周期数），调优用 */
 #define WELCOME_TUNE_ENABLE   1
 
 #define WELCOME_TUNE_MS_MIN   1200u
 #define WELCOME_TUNE_MS_MAX   4000u
 
-/* OLED 刷新 & 心跳 LED */
-#define OLED_REFRESH_MS       350u
+/* OLED 刷新（事件驱动，帧率上限/兜底间隔见 ui_refresh.h 的 UI_MAX_FPS/UI_IDLE_MS）& 心跳 LED */
+#define OLED_ANIM_MS          350u   /* 风扇动画一帧的间隔 */
+#define OLED_VDD_STEP_MV      20u    /* 电压变化超过这么多才更新显示 */
 #define HB_PERIOD_MS          2000u
 #define HB_ON_MS              60u
 
@@ -54,12 +69,19 @@
 #define NB_SRV_IP    "1.2.3.4"
 #define NB_SRV_PORT  9001
 
-/* === 周期性上报开关与周期 === */
+/* === 趋势曲线采样周期（每点一列，128 列） === */
+#define CHART_SAMPLE_MS     60000u
+
+/* === 周期性采样上报开关与采样周期 === */
 #define NB_DEMO_TX_ENABLE   1
 #define NB_DEMO_PERIOD_MS   10000u
 
-/* 页面定义（顺序保持：ENV -> LUX -> NB） */
-typedef enum { PAGE_ENV = 0, PAGE_LUX = 1, PAGE_NB = 2, PAGE_COUNT = 3 } page_t;
+/* 页面定义（顺序保持：ENV -> LUX -> NB -> CON） */
+typedef enum {
+  PAGE_ENV = 0, PAGE_TEMP_TREND, PAGE_HUMI_TREND,
+  PAGE_LUX, PAGE_LUX_TREND,
+  PAGE_NB, PAGE_CON, PAGE_COUNT
+} page_t;
 static volatile page_t g_page = PAGE_ENV;
 
 /* BH1750 运行期缓存 */
@@ -76,8 +98,13 @@ static uint32_t          g_next_lux_ms   = 0;
 #define MOTOR_BTN_PORT   GPIOB
 #define MOTOR_BTN_PIN    GPIO_PIN_11
 
-/* ====== NB 页显示缓冲（不加省略号） ====== */
+/* ====== NB 页：服务器最近下发的数据（不加省略号），最近一条进遥测包的读数 ====== */
 static char g_nb_last[64] = "--";
+static Tlm_Sample_t g_nb_smp;
+
+/* ====== 远程截屏请求（收到含 SNAP 的行时置位）：-1 无，0 普通，1 关键帧 ====== */
+static int8_t g_snap_req = -1;
+static uint8_t g_snap_busy = 0;   /* NB：有一行截屏在 AT 队列里，等它的完成回调再排下一行 */
 
 /* -------------------- 前置声明（仅本文件内部函数） -------------------- */
 static void Buttons_Init(void);
@@ -93,111 +120,85 @@ static void PlayWelcomeMelody(uint32_t max_ms);
 static inline void UI_NextPage(void){ g_page = (page_t)((g_page + 1) % PAGE_COUNT); }
 
 /* =============================================================================
- *                         顶部右侧图标（8px 高）
+ *            界面控件与页面（保留模式：值没变的控件不格式化也不重画）
  * ===========================================================================*/
-#undef  SPEAKER_W
-#define SPEAKER_W 12
-#undef  SPEAKER_H
-#define SPEAKER_H 8
-
-/* 基础绘图小工具 */
-static void draw_hline(int x,int y,int w){ for(int i=0;i<w;i++) SSD1306_DrawPixel(x+i,y,1); }
-static void fill_rect(int x,int y,int w,int h){ for(int r=0;r<h;r++) draw_hline(x,y+r,w); }
-static void clear_rect(int x,int y,int w,int h){
-  for(int r=0;r<h;r++){
-    for(int i=0;i<w;i++){ SSD1306_DrawPixel(x+i, y+r, 0); }
-  }
-}
-static void draw_line(int x0,int y0,int x1,int y1){
-  int dx = (x1>x0)? (x1-x0):(x0-x1), sx = (x0<x1)? 1:-1;
-  int dy = -((y1>y0)? (y1-y0):(y0-y1)), sy = (y0<y1)? 1:-1;
-  int err = dx + dy, e2;
-  for(;;){
-    SSD1306_DrawPixel(x0,y0,1);
-    if (x0==x1 && y0==y1) break;
-    e2 = 2*err;
-    if (e2 >= dy){ err += dy; x0 += sx; }
-    if (e2 <= dx){ err += dx; y0 += sy; }
-  }
-}
-
-/* 扬声器图标（报警提示） */
-static void Draw_SpeakerIcon(int x, int y){
-  const int s = 2;
-  const int square_x = x + 0;
-  const int square_y = y + (SPEAKER_H - s)/2;
-  const int rect_w = s;
-  const int rect_h = 3 * s;
-  const int rect_x = square_x + s;
-  const int rect_y = square_y - (rect_h - s)/2;
-
-  fill_rect(square_x, square_y, s, s);
-  fill_rect(rect_x, rect_y, rect_w, rect_h);
-
-  const int rx   = rect_x + rect_w;
-  const int midy = rect_y + rect_h/2;
-  const int Ls = 3;
-  const int Lm = 5;
-  draw_line(rx + 1, midy - 2, rx + 1 + Ls, midy - 3);
-  draw_line(rx + 1, midy,     rx + 1 + Lm, midy);
-  draw_line(rx + 1, midy + 2, rx + 1 + Ls, midy + 3);
-}
-
-/* 小风扇图标，phase 每次刷新+1 实现“旋转”动画 */
-static void Draw_FanIcon_8x8(int x, int y, uint8_t phase){
-  SSD1306_DrawPixel(x+4, y+4, 1);  // 中心点
-  uint8_t p = phase & 0x03;
-  const int dirs[4][3][2] = {
-    {{ 0,-3},{ 3, 0},{-3, 0}},
-    {{ 2,-2},{ 2, 2},{-2, 2}},
-    {{ 0, 3},{ 3, 0},{-3, 0}},
-    {{-2,-2},{ 2,-2},{-2, 2}},
-  };
-  for (int i=0;i<3;i++){
-    int dx = dirs[p][i][0], dy = dirs[p][i][1];
-    SSD1306_DrawPixel(x+4+dx, y+4+dy, 1);
-    if (dx) SSD1306_DrawPixel(x+4+(dx>0?dx-1:dx+1), y+4+dy, 1);
-    if (dy) SSD1306_DrawPixel(x+4+dx, y+4+(dy>0?dy-1:dy+1), 1);
-  }
-}
-
-/* 手动模式图标（8x8，字母 'M'） */
-static void Draw_ManualIcon_8x8(int x, int y){
-  for (int i=0;i<8;i++){ // 立柱
-    SSD1306_DrawPixel(x+1, y+i, 1);
-    SSD1306_DrawPixel(x+6, y+i, 1);
-  }
-  // 顶部横线
-  for (int i=1;i<=6;i++) SSD1306_DrawPixel(x+i, y, 1);
-  // 中间形成 "M"
-  SSD1306_DrawPixel(x+2, y+1, 1);
-  SSD1306_DrawPixel(x+3, y+2, 1);
-  SSD1306_DrawPixel(x+4, y+2, 1);
-  SSD1306_DrawPixel(x+5, y+1, 1);
-}
-
-/* ===== NB 两行显示（不加省略号，超出宽度直接裁掉） ===== */
-static void draw_nb_two_lines(int y1, int y2){
-  const int chars_per_line = SSD1306_WIDTH / 6; // 21
-  const char* s = g_nb_last;
-  char l1[32]={0}, l2[32]={0};
-  size_t len = strlen(s);
-
-  if (len == 0) { strcpy(l1, "--"); l2[0]=0; }
-  else {
-    strncpy(l1, s, chars_per_line);
-    l1[chars_per_line] = 0;
-    if (len > (size_t)chars_per_line){
-      strncpy(l2, s + chars_per_line, chars_per_line);
-      l2[chars_per_line] = 0;
-    }
-  }
-
-  clear_rect(0, y1, SSD1306_WIDTH, 8);
-  clear_rect(0, y2, SSD1306_WIDTH, 8);
+/* 顶部右侧图标为预渲染位图（tools/ui_sprites.txt），正好占第 0 页，换帧只写几个字节 */
+#define SPEAKER_W 12                         /* 喇叭占位宽（图标 11 列 + 1 列间隔） */
+
+/* 标题类固定内容用 UI_CHROME：每页第一次显示时画进页模板，之后换页直接拷（见 ui_widget.h） */
+/* 公共：顶部标题 + 右侧三个图标（喇叭最右，风扇左 10px，“M”再左 10px）+ 底部 VDD */
+static UI_Widget_t w_header  = UI_CHROME_ID(0, 0, SSD1306_WIDTH - SPEAKER_W - 20, UI_ALIGN_LEFT, UI_STR_HEADER);
+static UI_Widget_t w_speaker = UI_SPRITE(SSD1306_WIDTH - SPEAKER_W,      0, SPEAKER);
+static UI_Widget_t w_fan     = UI_SPRITE(SSD1306_WIDTH - SPEAKER_W - 10, 0, FAN);
+static UI_Widget_t w_manual  = UI_SPRITE(SSD1306_WIDTH - SPEAKER_W - 20, 0, MANUAL);
+#if OLED_BENCH_ENABLE
+/* 调优：改显示“c上一帧渲染周期 f帧率 spiSPI占用率” */
+static UI_Widget_t w_vdd     = UI_LABEL(0, 56, SSD1306_WIDTH, UI_ALIGN_CENTER, "");
+#else
+static UI_Widget_t w_vdd     = UI_NUMBER(0, 56, SSD1306_WIDTH, UI_ALIGN_CENTER, "VDD=", 0, 0, " mV");
+#endif
 
-  draw_centered6x8(y1, l1);
-  if (l2[0]) draw_centered6x8(y2, l2);
+/* ENV：温度用 32 行大字（第 2~5 页），湿度一行小字 */
+static UI_Widget_t w_env_title = UI_CHROME(0, 8, SSD1306_WIDTH, UI_ALIGN_CENTER, "DHT11");
+static UI_Widget_t w_env_l1    = UI_BIGNUMBER(0, 16, SSD1306_WIDTH, UI_ALIGN_CENTER, "", 0, 0, "°C", BIGFONT_32);
+static UI_Widget_t w_env_l2    = UI_NUMBER(0, 48, SSD1306_WIDTH, UI_ALIGN_CENTER, "Hum:", 2, 0, " %");
+/* LUX：照度用 24 行大字（第 2~4 页） */
+static UI_Widget_t w_lux_title = UI_CHROME(0, 8, SSD1306_WIDTH, UI_ALIGN_CENTER, "BH1750");
+static UI_Widget_t w_lux_l1    = UI_BIGNUMBER(0, 16, SSD1306_WIDTH, UI_ALIGN_CENTER, "", 0, 1, "lx", BIGFONT_24);
+static UI_Widget_t w_lux_l2    = UI_LABEL(0, 44, SSD1306_WIDTH, UI_ALIGN_CENTER, "");
+/* NB：一行最近上报的读数（数字控件，不走 printf），两行窗口显示服务器下发的数据（不加省略号，超出宽度直接裁掉） */
+static UI_Widget_t w_nb_title  = UI_CHROME(0, 8, SSD1306_WIDTH, UI_ALIGN_CENTER, "NB");
+static UI_Widget_t w_nb_t      = UI_NUMBER(0,  16, 40, UI_ALIGN_CENTER, "T:", 0, 0, "C");
+static UI_Widget_t w_nb_h      = UI_NUMBER(40, 16, 40, UI_ALIGN_CENTER, "H:", 0, 0, "%");
+static UI_Widget_t w_nb_l      = UI_NUMBER(80, 16, 48, UI_ALIGN_CENTER, "L:", 0, 0, "");
+static UI_Widget_t w_nb_text   = UI_TEXTBOX2(28);
+static UI_Widget_t w_nb_baud   = UI_NUMBER(0, 44, SSD1306_WIDTH, UI_ALIGN_CENTER, "Baud:", 0, 0, "");
+/* 趋势页：第 1 页写名称和曲线内的最低~最高，第 2~6 页（40 行）画曲线 */
+#define CHART_Y   16
+#define CHART_H   40
+UI_CHART_DEF(c_temp, SSD1306_WIDTH, 4);       /* 纵轴至少 4 C */
+UI_CHART_DEF(c_humi, SSD1306_WIDTH, 10);      /* 至少 10 % */
+UI_CHART_DEF(c_lux,  SSD1306_WIDTH, 20);      /* 至少 20 lx */
+static UI_Widget_t w_temp_cap   = UI_LABEL(0, 8, SSD1306_WIDTH, UI_ALIGN_LEFT, "Temp --");
+static UI_Widget_t w_temp_chart = UI_CHART(0, CHART_Y, SSD1306_WIDTH, CHART_H, c_temp);
+static UI_Widget_t w_humi_cap   = UI_LABEL(0, 8, SSD1306_WIDTH, UI_ALIGN_LEFT, "Humi --");
+static UI_Widget_t w_humi_chart = UI_CHART(0, CHART_Y, SSD1306_WIDTH, CHART_H, c_humi);
+static UI_Widget_t w_lux_cap    = UI_LABEL(0, 8, SSD1306_WIDTH, UI_ALIGN_LEFT, "Lux --");
+static UI_Widget_t w_lux_chart  = UI_CHART(0, CHART_Y, SSD1306_WIDTH, CHART_H, c_lux);
+/* 低压告警（整屏） */
+static UI_Widget_t w_low_l1    = UI_CHROME(0, 0,  SSD1306_WIDTH, UI_ALIGN_CENTER, "LOW VDD!");
+static UI_Widget_t w_low_l2    = UI_NUMBER(0, 16, SSD1306_WIDTH, UI_ALIGN_CENTER, "VDD=", 0, 0, "mV");
+static UI_Widget_t w_low_l3    = UI_CHROME(0, 32, SSD1306_WIDTH, UI_ALIGN_CENTER, "Check 5V/3V3");
+
+static UI_Widget_t* const PG_ENV_W[] = { &w_header, &w_manual, &w_fan, &w_speaker,
+                                         &w_env_title, &w_env_l1, &w_env_l2, &w_vdd };
+static UI_Widget_t* const PG_LUX_W[] = { &w_header, &w_manual, &w_fan, &w_speaker,
+                                         &w_lux_title, &w_lux_l1, &w_lux_l2, &w_vdd };
+static UI_Widget_t* const PG_NB_W[]  = { &w_header, &w_manual, &w_fan, &w_speaker,
+                                         &w_nb_title, &w_nb_t, &w_nb_h, &w_nb_l, &w_nb_text, &w_nb_baud, &w_vdd };
+static UI_Widget_t* const PG_LOW_W[] = { &w_low_l1, &w_low_l2, &w_low_l3 };
+static UI_Widget_t* const PG_TEMP_TREND_W[] = { &w_header, &w_manual, &w_fan, &w_speaker,
+                                                &w_temp_cap, &w_temp_chart, &w_vdd };
+static UI_Widget_t* const PG_HUMI_TREND_W[] = { &w_header, &w_manual, &w_fan, &w_speaker,
+                                                &w_humi_cap, &w_humi_chart, &w_vdd };
+static UI_Widget_t* const PG_LUX_TREND_W[]  = { &w_header, &w_manual, &w_fan, &w_speaker,
+                                                &w_lux_cap, &w_lux_chart, &w_vdd };
+
+/* PAGE_CON 不走控件层，由 oled_console 直接管整屏 */
+static const UI_Page_t UI_PAGES[PAGE_COUNT] = {
+  [PAGE_ENV] = UI_PAGE(PG_ENV_W), [PAGE_LUX] = UI_PAGE(PG_LUX_W), [PAGE_NB] = UI_PAGE(PG_NB_W),
+  [PAGE_TEMP_TREND] = UI_PAGE(PG_TEMP_TREND_W),
+  [PAGE_HUMI_TREND] = UI_PAGE(PG_HUMI_TREND_W),
+  [PAGE_LUX_TREND]  = UI_PAGE(PG_LUX_TREND_W),
+};
+static const UI_Page_t UI_PAGE_LOW_VDD      = UI_PAGE(PG_LOW_W);
+
+/* 趋势页标题：名称 + 曲线内（最近 128 点）的最低~最高 */
+static void chart_caption(UI_Widget_t* cap, const char* name, const UI_Chart_t* c, const char* unit){
+  char s[24];
+  if (!c->count) snprintf(s, sizeof(s), "%s --", name);
+  else           snprintf(s, sizeof(s), "%s %d~%d%s", name, c->min, c->max, unit);
+  UI_SetText(cap, s);
 }
 
 /* ===== UI 小工具：6x8 字体整行居中 ===== */
@@ -348,14 +349,100 @@ static void RunSelfTest(SelfTestResult* r){
   }
 }
 
-/* ===== Lux 文本（1 位小数） ===== */
-static void fmt_lux_1dp(char *buf, size_t n, float v){
-  if (!buf || n < 8) return;
-  int32_t lx10 = (int32_t)(v * 10 + (v >= 0 ? 0.5f : -0.5f));
-  long ip = lx10 / 10; long fp = lx10 % 10; if (fp < 0) fp = -fp;
-  snprintf(buf, n, "Lux: %ld.%ld lx", ip, fp);
+/* ===== 欢迎页：两行放大字，整体略偏上 ===== */
+static void draw_welcome(void){
+  const int scale_x = 2, scale_y = 1;
+  const int line_h  = 8 * scale_y;
+  const int gap     = 12;
+  const int total_h = line_h * 2 + gap;
+  const int lift    = 4;
+  int y0_base = (SSD1306_HEIGHT - total_h) / 2;
+  int y0      = y0_base - lift;
+  if (y0 < 0) y0 = 0;
+  SSD1306_Fill(0);
+  OLED_DrawText_CenteredScaled(y0,                UI_STR_WELCOME, 1, scale_x, scale_y);
+  OLED_DrawText_CenteredScaled(y0 + line_h + gap, UI_STR_PRODUCT, 1, scale_x, scale_y);
+}
+
+/* ===== 自检结果页 ===== */
+static void draw_hw_check(const SelfTestResult* r){
+  char line[64];
+  SSD1306_Fill(0);
+  OLED_DrawText_CenteredScaled(0, UI_STR_HW_CHECK, 1, 2, 1);
+  snprintf(line, sizeof(line), "OLED %s", r->oled_visual ? "OK" : "ERR");           draw_centered6x8(20, line);
+  snprintf(line, sizeof(line), "BH1750 %s  DHT11 %s",
+           (r->bh_found && r->bh_read_ok) ? "OK" : "ERR", r->dht_ok ? "OK" : "ERR");draw_centered6x8(32, line);
+
+  /* NB 行固定显示 “NB loading...” */
+  draw_centered6x8(44, "NB loading...");
+
+  snprintf(line, sizeof(line), "VDD=%umV", (unsigned)r->vdd_mv);                     draw_centered6x8(56, line);
+}
+
+/* ===== Lux ×10（四舍五入，界面按 1 位小数显示） ===== */
+static int32_t lux_x10(float v){
+  return (int32_t)(v * 10 + (v >= 0 ? 0.5f : -0.5f));
 }
 
+/* ===== 绘图耗时测量（DWT 周期数；SoftI2C_Begin 已开 CYCCNT） ===== */
+#if OLED_BENCH_ENABLE
+static void OLED_Bench(void){
+  static const char* s = "VDD=3301 mV Tem:25 C";   /* 20 字符，接近一整行 */
+  char line[32];
+  static const uint8_t hdr[6] = { 0x21, 0, 127, 0x22, 0, 0 };      /* 刷新时每页的窗口命令 */
+  uint32_t c0, c_str, c_str_u, c_big, c_clr, c_hdr, c_init, c_pg_cold, c_pg_warm, c_num_s, c_num_b;
+
+  c0 = DWT->CYCCNT;
+  for (int i = 0; i < 8; i++) SSD1306_DrawString(0, i * 8, s);
+  c_str = (DWT->CYCCNT - c0) / 8;
+
+  c0 = DWT->CYCCNT;
+  for (int i = 0; i < 7; i++) SSD1306_DrawString(0, i * 8 + 3, s);   /* 非 8 对齐：跨两页 */
+  c_str_u = (DWT->CYCCNT - c0) / 7;
+
+  c0 = DWT->CYCCNT;
+  OLED_DrawText_CenteredScaled(0, UI_STR_HW_CHECK, 1, 2, 1);   /* 与自检标题同参数 */
+  c_big = DWT->CYCCNT - c0;
+
+  /* 大读数：FONT5x7 放大 3×4（约 15×28，逐点路径）对比 32 行大字库 */
+  c0 = DWT->CYCCNT;
+  SSD1306_DrawStringCenteredScaled(16, "25 C", 3, 4, 1);
+  c_num_s = DWT->CYCCNT - c0;
+  c0 = DWT->CYCCNT;
+  BigFont_DrawText(30, 16, BIGFONT_32, "25°C");
+  c_num_b = DWT->CYCCNT - c0;
+
+  c0 = DWT->CYCCNT;
+  SSD1306_FillRect(0, 28, SSD1306_WIDTH, 8, 0);                      /* 页面里清一行的常用操作 */
+  c_clr = DWT->CYCCNT - c0;
+
+  /* 换页：第一次（建模板）与再次进入（拷模板 + 只画动态控件） */
+  UI_Show(&UI_PAGES[PAGE_ENV]); c_pg_cold = UI_GetStats()->show_cycles;
+  UI_Show(&UI_PAGES[PAGE_LUX]);
+  UI_Show(&UI_PAGES[PAGE_ENV]); c_pg_warm = UI_GetStats()->show_cycles;
+
+  c0 = DWT->CYCCNT;
+  SSD1306_WriteCommands(hdr, sizeof(hdr));
+  c_hdr = DWT->CYCCNT - c0;
+
+  c0 = DWT->CYCCNT;
+  SSD1306_Init();                                                    /* 含复位 2×5ms 与整屏清零 */
+  c_init = (DWT->CYCCNT - c0) / (SystemCoreClock / 1000000u);
+
+  SSD1306_Fill(0);
+  draw_centered6x8(0, "Render (cycles)");
+  snprintf(line, sizeof(line), "Page %lu>%lu", (unsigned long)c_pg_cold, (unsigned long)c_pg_warm); draw_centered6x8(8, line);
+  snprintf(line, sizeof(line), "Str %lu/%lu", (unsigned long)c_str, (unsigned long)c_str_u); draw_centered6x8(16, line);
+  snprintf(line, sizeof(line), "Num %lu>%lu", (unsigned long)c_num_s, (unsigned long)c_num_b); draw_centered6x8(24, line);
+  snprintf(line, sizeof(line), "Big  %lu", (unsigned long)c_big);    draw_centered6x8(32, line);
+  snprintf(line, sizeof(line), "Clr  %lu", (unsigned long)c_clr);    draw_centered6x8(40, line);
+  snprintf(line, sizeof(line), "Hdr  %lu", (unsigned long)c_hdr);    draw_centered6x8(48, line);
+  snprintf(line, sizeof(line), "Init %lu us", (unsigned long)c_init); draw_centered6x8(56, line);
+  SSD1306_Update();
+  HAL_Delay(SELFTEST_SHOW_MS);
+}
+#endif
+
 /* ===== 开机曲：一闪一闪亮晶晶 ===== */
 typedef struct { uint16_t f; uint8_t beats; } tw_note_t;
 static void PlayWelcomeMelody(uint32_t max_ms){
@@ -388,6 +475,50 @@ static void PlayWelcomeMelody(uint32_t max_ms){
 void SystemClock_Config(void);
 void Error_Handler(void);
 
+/* NB 收发日志：记进控制台历史，并通知刷新（控制台在显示时新行已画进帧缓冲） */
+static void nb_log(char tag, const char* s){
+  Console_PushTagged(tag, s);
+  UI_Post(UI_EV_NB);
+  if (tag == '<'){
+    int k = Snap_ParseCommand(s);          /* 只记下请求，截屏在主循环里发（这里还在 AT 收发中途） */
+    if (k > g_snap_req) g_snap_req = (int8_t)k;
+  }
+}
+
+/* 服务器下发的数据：显示在 NB 页（截屏命令已由 nb_log 按行识别） */
+static void nb_recv(const char* data, int len){
+  (void)len;
+  strncpy(g_nb_last, data, sizeof(g_nb_last)-1);
+  g_nb_last[sizeof(g_nb_last)-1] = 0;
+  UI_Post(UI_EV_NB);
+}
+
+/* 有 NB 时截屏行一次只排一行进 AT 队列（一行约 230 字节，整张一起排会占满 NB_AT_BUF，
+ * 排不下的后几行丢了、前几行照样发出去）。上一行的回调回来才排下一行；一行失败就丢掉剩下的，
+ * 下一张改发关键帧。 */
+static void snap_failed(void){
+  Snap_Reset();
+  Console_Push("snap: send failed");
+  UI_Post(UI_EV_NB);
+}
+static void snap_nb_done(int res, void* ctx){
+  (void)ctx;
+  g_snap_busy = 0;
+  if (res != NB_AT_OK) snap_failed();
+}
+static int snap_nb_line(const char* s){
+  int r = NB_SendLineAsync(s, snap_nb_done, NULL);
+  if (r == 0) g_snap_busy = 1;
+  return r;
+}
+
+/* 没有 NB 模组（串口直连蓝牙/USB 转串口）时截屏行直接从 USART1 发出 */
+static int snap_uart_line(const char* s){
+  static const uint8_t crlf[2] = { '\r', '\n' };
+  if (HAL_UART_Transmit(&huart1, (uint8_t*)s, (uint16_t)strlen(s), 500) != HAL_OK) return -1;
+  return (HAL_UART_Transmit(&huart1, (uint8_t*)crlf, 2, 50) == HAL_OK) ? 0 : -1;
+}
+
 /* ===== 温湿报警（≥/≤ 触发；迟滞+冷却） ===== */
 typedef struct {
   uint8_t temp_abn; uint8_t humi_abn;
@@ -502,11 +633,17 @@ int main(void)
   SystemCoreClockUpdate();
 
   MX_GPIO_Init();
+#if SSD1306_BUS == SSD1306_BUS_I2C
+  MX_I2C1_Init();                               // OLED 走 I2C1（PB8/PB9）
+#else
   MX_SPI1_Init();
+#endif
   MX_USART1_UART_Init();
 
-  /* NB init (APN/IP/PORT) */
-  NB_Init(NB_APN, NB_SRV_IP, NB_SRV_PORT);
+  /* NB init (APN/IP/PORT)：只排队，握手/附着/开 socket 由主循环里的 NB_Poll() 推进；收发日志记进控制台历史 */
+  NB_SetLogHook(nb_log);
+  NB_SetRecvHook(nb_recv);
+  NB_InitAsync(NB_APN, NB_SRV_IP, NB_SRV_PORT);
   MX_ADC1_Init();
 
   /* TIM2 用作电机 PWM（CubeMX 需已开启 TIM2 CH1@PA0） */
@@ -518,19 +655,7 @@ int main(void)
 
   /* 欢迎页 */
   SSD1306_Init();
-  SSD1306_Fill(0);
-  {
-    const int scale_x = 2, scale_y = 1;
-    const int line_h  = 8 * scale_y;
-    const int gap     = 12;
-    const int total_h = line_h * 2 + gap;
-    const int lift    = 4;
-    int y0_base = (SSD1306_HEIGHT - total_h) / 2;
-    int y0      = y0_base - lift;
-    if (y0 < 0) y0 = 0;
-    SSD1306_DrawStringCenteredScaled(y0,                "Welcome to",            1, scale_x, scale_y);
-    SSD1306_DrawStringCenteredScaled(y0 + line_h + gap, "AI Farmland Terminal",  1, scale_x, scale_y);
-  }
+  draw_welcome();
   SSD1306_Update();
 #if WELCOME_TUNE_ENABLE
   PlayWelcomeMelody(WELCOME_SHOW_MS);
@@ -546,20 +671,14 @@ int main(void)
   SelfTestResult st = {0};
   RunSelfTest(&st);
 
-  char line[64];
-  SSD1306_Fill(0);
-  SSD1306_DrawStringCenteredScaled(0, "Hardware Check", 1, 2, 1);
-  snprintf(line, sizeof(line), "OLED %s", st.oled_visual ? "OK" : "ERR");           draw_centered6x8(20, line);
-  snprintf(line, sizeof(line), "BH1750 %s  DHT11 %s",
-           (st.bh_found && st.bh_read_ok) ? "OK" : "ERR", st.dht_ok ? "OK" : "ERR");draw_centered6x8(32, line);
-
-  /* NB 行固定显示 “NB loading...” */
-  draw_centered6x8(44, "NB loading...");
-
-  snprintf(line, sizeof(line), "VDD=%umV", (unsigned)st.vdd_mv);                     draw_centered6x8(56, line);
+  draw_hw_check(&st);
   SSD1306_Update();
   HAL_Delay(SELFTEST_SHOW_MS);
 
+#if OLED_BENCH_ENABLE
+  OLED_Bench();
+#endif
+
   /* 运行期变量 */
   Buttons_Init();
   BEEP_off();
@@ -569,15 +688,17 @@ int main(void)
   uint8_t   have_valid_dht = st.dht_ok;
   uint32_t  next_dht_ms    = HAL_GetTick();
   const uint32_t DHT_PERIOD_MS = 2000;
-  uint32_t  next_oled_ms   = HAL_GetTick();
+  uint32_t  next_anim_ms   = HAL_GetTick();
+  uint32_t  next_chart_ms  = HAL_GetTick();
   uint32_t  last_vdd_mv    = st.vdd_mv;
+  uint32_t  shown_vdd_mv   = st.vdd_mv;
+  uint8_t   shown_low_vdd  = 0;
   HAL_StatusTypeDef last_dht_status = st.dht_ok ? HAL_OK : HAL_ERROR;
 
   if (!have_valid_dht){
     for (int i = 0; i < 5; i++) { if (DHT11_Read(&d) == HAL_OK){ have_valid_dht = 1; break; } HAL_Delay(250); }
   }
 
-  static uint8_t fan_phase = 0;
 
   /* ============================== 主循环 ============================== */
   for (;;)
@@ -589,11 +710,15 @@ int main(void)
     if (now >= next_btn_scan){
       next_btn_scan = now + 10;
 
-      /* PB10: 下一页 */
-      if (NextPageButton_Scan10ms() == 1) UI_NextPage();
+      /* PB10: 下一页；控制台页先往回翻历史，翻到最早一屏再切页 */
+      if (NextPageButton_Scan10ms() == 1){
+        if (!(g_page == PAGE_CON && Console_PageUp())) UI_NextPage();
+        UI_Post(UI_EV_INPUT);
+      }
 
       /* PB11: 电机按钮（短按=进入/留在手动并启停，长按=退出手动） */
       uint8_t mEvt = MotorButton_Update10ms();
+      if (mEvt) UI_Post(UI_EV_INPUT);
       if (mEvt == 1){ // 短按
         if (g_motor.mode == MOTOR_AUTO){
           // 从自动 → 手动，并立即启动
@@ -614,6 +739,7 @@ int main(void)
     /* —— 传感器 —— */
     if (now >= g_next_lux_ms){
       float lx; HAL_StatusTypeDef stlux = BH1750_ReadLux(&lx);
+      if (stlux != g_bh1750_status || (stlux == HAL_OK && lux_x10(lx) != lux_x10(g_last_lux))) UI_Post(UI_EV_SENSOR);
       g_bh1750_status = stlux; if (stlux == HAL_OK) g_last_lux = lx;
       g_next_lux_ms = now + 500;
     }
@@ -623,11 +749,20 @@ int main(void)
     /* 供电监测 */
     last_vdd_mv = Read_VDDA_mV();
     uint8_t low_vdd = (last_vdd_mv < 3050);
+    if (low_vdd != shown_low_vdd ||
+        last_vdd_mv + OLED_VDD_STEP_MV <= shown_vdd_mv || last_vdd_mv >= shown_vdd_mv + OLED_VDD_STEP_MV){
+      shown_vdd_mv  = last_vdd_mv;
+      shown_low_vdd = low_vdd;
+      UI_Post(UI_EV_POWER);
+    }
 
     /* DHT11 每 2 秒采样一次（低压跳过） */
     if (!low_vdd && now >= next_dht_ms) {
+      DHT11_DataTypeDef prev = d;
       HAL_StatusTypeDef st_d2 = DHT11_Read(&d);
       if (st_d2 != HAL_OK) { HAL_Delay(200); st_d2 = DHT11_Read(&d); }
+      if (st_d2 != last_dht_status || d.temperature != prev.temperature || d.humidity != prev.humidity)
+        UI_Post(UI_EV_SENSOR);
       last_dht_status = st_d2;
       if (st_d2 == HAL_OK) have_valid_dht = 1;
       next_dht_ms = now + DHT_PERIOD_MS;
@@ -635,28 +770,67 @@ int main(void)
 
     /* 报警判定 */
     if (!low_vdd && have_valid_dht && last_dht_status == HAL_OK){
+      uint8_t abn = (uint8_t)(g_alarm.temp_abn | (g_alarm.humi_abn << 1));
       Alarm_CheckAndBeep(&d, now);
+      if (abn != (uint8_t)(g_alarm.temp_abn | (g_alarm.humi_abn << 1))) UI_Post(UI_EV_ALARM);
     }
 
 #if NB_DEMO_TX_ENABLE
+    /* 每 NB_DEMO_PERIOD_MS 采一条进遥测包（攒够条数或等够时间才发一个 UDP 包，见 telemetry.h） */
     static uint32_t next_demo_tx = 0;
     if (now >= next_demo_tx){
-      char msg[64]; int n = 0;
-      n += snprintf(msg+n, sizeof(msg)-n, "VDD=%lu", (unsigned long)last_vdd_mv);
+      Tlm_Sample_t smp = { .t_ms = now, .vdd_mv = (uint16_t)last_vdd_mv };
       if (have_valid_dht && last_dht_status==HAL_OK){
-        n += snprintf(msg+n, sizeof(msg)-n, " T=%dC H=%d%%", d.temperature, d.humidity);
+        smp.temp = d.temperature; smp.humi = d.humidity; smp.flags |= TLM_HAS_DHT;
       }
       if (g_bh1750_status==HAL_OK){
-        int lux = (int)(g_last_lux + 0.5f);
-        n += snprintf(msg+n, sizeof(msg)-n, " L=%d", lux);
+        smp.lux = (uint32_t)(g_last_lux + 0.5f); smp.flags |= TLM_HAS_LUX;
       }
-      NB_SendLine(msg);
-      strncpy(g_nb_last, msg, sizeof(g_nb_last)-1);
-      g_nb_last[sizeof(g_nb_last)-1]=0;
+      Tlm_Add(&smp);
+      g_nb_smp = smp;                    /* NB 页用数字控件显示，值没变不格式化 */
+      UI_Post(UI_EV_NB);
       next_demo_tx = now + NB_DEMO_PERIOD_MS;
     }
+    Tlm_Poll(now);
 #endif
 
+    /* —— NB：推进 AT 队列（发命令/收回复/超时），模组主动上报的行也在这里收下，不等待 —— */
+    NB_Poll();
+
+    /* —— 远程截屏：压缩后分行发回（有 NB 走 UDP，否则走串口），主机用 tools/oled_snap.py 还原 ——
+     * NB 上一张还在发时新请求先留着，发完再截 */
+    if (g_snap_req >= 0 && !Snap_Pending() && !g_snap_busy){
+      uint8_t key = (uint8_t)g_snap_req;
+      g_snap_req = -1;
+      int n = g_nb.inited ? Snap_Begin(key) : Snap_Send(snap_uart_line, key);
+      char msg[24];
+      if (n < 0) snprintf(msg, sizeof(msg), "snap: send failed");
+      else       snprintf(msg, sizeof(msg), "snap: %d bytes", n);
+      Console_Push(msg);
+      UI_Post(UI_EV_NB);
+    }
+    if (Snap_Pending() && !g_snap_busy){
+      int r = Snap_SendNext(snap_nb_line);
+      if (r < 0 && r != NB_AT_FULL) snap_failed();     /* 队列满（遥测包等占着）下一圈再排 */
+    }
+
+    /* —— 趋势曲线采样（读数无效的那一点跳过） —— */
+    if (now >= next_chart_ms){
+      if (!low_vdd && have_valid_dht && last_dht_status == HAL_OK){
+        UI_ChartPush(&w_temp_chart, (int16_t)d.temperature);
+        UI_ChartPush(&w_humi_chart, (int16_t)d.humidity);
+        chart_caption(&w_temp_cap, "Temp", &c_temp, " C");
+        chart_caption(&w_humi_cap, "Humi", &c_humi, " %");
+      }
+      if (g_bh1750_status == HAL_OK){
+        float lx = g_last_lux + 0.5f;
+        UI_ChartPush(&w_lux_chart, (int16_t)((lx > 32767.0f) ? 32767 : (int)lx));   /* 超出按 32767 画 */
+        chart_caption(&w_lux_cap, "Lux", &c_lux, " lx");
+      }
+      UI_Post(UI_EV_SENSOR);
+      next_chart_ms = now + CHART_SAMPLE_MS;
+    }
+
     /* —— 电机控制 —— */
     uint8_t target = 0;
     if (g_motor.mode == MOTOR_MANUAL){
@@ -666,79 +840,91 @@ int main(void)
       else target = 0;
     }
     MOTOR_SetDutyPct(target);
+    if (target != g_motor.duty_pct) UI_Post(UI_EV_MOTOR);
     g_motor.duty_pct = target;
 
-    /* —— OLED 刷新 —— */
-    if (now >= next_oled_ms) {
-      SSD1306_Fill(0);
+    /* 风扇转动时按固定节拍走动画帧 */
+    if (g_motor.duty_pct > 0 && now >= next_anim_ms){
+      next_anim_ms = now + OLED_ANIM_MS;
+      UI_Post(UI_EV_ANIM);
+    }
+
+    /* —— OLED 刷新 —— 有事件才刷（受帧率上限约束）；只更新控件的值，值没变的控件不会重画 */
+    uint32_t ui_ev = UI_RefreshDue(now);
+    if (ui_ev) {
+      static const UI_Page_t* shown = NULL;
+      const UI_Page_t* pg = NULL;            /* NULL = 控制台页 */
 
       if (low_vdd) {
-        draw_centered6x8(0,  "LOW VDD!");
-        snprintf(line, sizeof(line), "VDD=%lumV", (unsigned long)last_vdd_mv);
-        draw_centered6x8(16, line);
-        draw_centered6x8(32, "Check 5V/3V3");
+        UI_SetNumber(&w_low_l2, (int32_t)shown_vdd_mv);
+        pg = &UI_PAGE_LOW_VDD;
       } else {
-        /* 顶部左：标题 */
-        SSD1306_DrawString(0, 0, "Hello STM32");
-
-        /* 顶部右：报警喇叭（最右） */
-        int right_x = SSD1306_WIDTH - SPEAKER_W;
-        if (g_alarm.temp_abn || g_alarm.humi_abn){
-          Draw_SpeakerIcon(right_x, 0);   // 12x8
-        }
-        /* 顶部右：风扇图标（在喇叭左边 10px，只有占空比>0 时显示并转动） */
-        if (g_motor.duty_pct > 0){
-          Draw_FanIcon_8x8(right_x - 10, 0, fan_phase++);
-        }
-        /* 顶部右：手动模式“M”图标（在风扇左边 10px，仅手动模式显示） */
-        if (g_motor.mode == MOTOR_MANUAL){
-          Draw_ManualIcon_8x8(right_x - 20, 0);
-        }
+        UI_SetIcon(&w_speaker, (g_alarm.temp_abn || g_alarm.humi_abn) ? 1 : 0);
+        /* 风扇只有占空比>0 时显示，动画节拍到了才走一帧 */
+        if (g_motor.duty_pct == 0)                          UI_Animate(&w_fan, 0);
+        else if ((ui_ev & UI_EV_ANIM) || !w_fan.value)      UI_Animate(&w_fan, 1);
+        UI_SetIcon(&w_manual, (g_motor.mode == MOTOR_MANUAL) ? 1 : 0);
 
         switch (g_page) {
-          case PAGE_ENV: {
-            draw_centered6x8(16, "DHT11");
-            clear_rect(0, 28, SSD1306_WIDTH, 8);
-            clear_rect(0, 36, SSD1306_WIDTH, 8);
+          case PAGE_ENV:
             if (have_valid_dht && last_dht_status == HAL_OK) {
-              snprintf(line, sizeof(line), "Tem:%2d C", d.temperature); draw_centered6x8(28, line);
-              snprintf(line, sizeof(line), "Hum:%2d %%", d.humidity);   draw_centered6x8(36, line);
+              UI_SetNumber(&w_env_l1, d.temperature);
+              UI_SetNumber(&w_env_l2, d.humidity);
             } else {
-              draw_centered6x8(28, "NO DHT11");
-              draw_centered6x8(36, "or wiring error");
+              UI_SetText(&w_env_l1, "NO DHT11");
+              UI_SetText(&w_env_l2, "or wiring error");
             }
             break;
-          }
-          case PAGE_LUX: {
-            draw_centered6x8(16, "BH1750");
-            clear_rect(0, 28, SSD1306_WIDTH, 8);
-            clear_rect(0, 36, SSD1306_WIDTH, 8);
+          case PAGE_LUX:
             if (g_bh1750_status == HAL_OK){
-              fmt_lux_1dp(line, sizeof(line), g_last_lux); draw_centered6x8(28, line);
+              UI_SetNumber(&w_lux_l1, lux_x10(g_last_lux));
+              UI_SetText(&w_lux_l2, "");
             }else{
-              draw_centered6x8(28, "BH1750 N/A");
-              draw_centered6x8(36, "Check ADDR/I2C");
+              UI_SetText(&w_lux_l1, "BH1750 N/A");
+              UI_SetText(&w_lux_l2, "Check ADDR/I2C");
             }
             break;
-          }
-          case PAGE_NB: {
-            draw_centered6x8(16, "NB");
-            draw_nb_two_lines(28, 36); // 两行空间
-            clear_rect(0, 44, SSD1306_WIDTH, 8);
-            snprintf(line, sizeof(line), "Baud:%lu", (unsigned long)huart1.Init.BaudRate);
-            draw_centered6x8(44, line);
+          case PAGE_NB:
+            if (g_nb_smp.flags & TLM_HAS_DHT){
+              UI_SetNumber(&w_nb_t, g_nb_smp.temp);
+              UI_SetNumber(&w_nb_h, g_nb_smp.humi);
+            } else {
+              UI_SetText(&w_nb_t, "T:--");
+              UI_SetText(&w_nb_h, "H:--");
+            }
+            if (g_nb_smp.flags & TLM_HAS_LUX) UI_SetNumber(&w_nb_l, (int32_t)g_nb_smp.lux);
+            else                              UI_SetText(&w_nb_l, "L:--");
+            UI_SetText(&w_nb_text, g_nb_last);
+            UI_SetNumber(&w_nb_baud, (int32_t)huart1.Init.BaudRate);
             break;
-          }
           default: break;
         }
 
-        /* 底部 VDD 居中（所有页面共用） */
-        snprintf(line, sizeof(line), "VDD=%lu mV", (unsigned long)last_vdd_mv);
-        draw_centered6x8(56, line);
+#if OLED_BENCH_ENABLE
+        {
+          const UI_RefreshStats_t* rs = UI_GetRefreshStats();
+          char diag[24];
+          snprintf(diag, sizeof(diag), "c%lu f%u.%u spi%u.%u%%", (unsigned long)UI_GetStats()->last_cycles,
+                   rs->fps_x10 / 10u, rs->fps_x10 % 10u, rs->spi_permille / 10u, rs->spi_permille % 10u);
+          UI_SetText(&w_vdd, diag);
+        }
+#else
+        UI_SetNumber(&w_vdd, (int32_t)shown_vdd_mv);
+#endif
+        if (g_page != PAGE_CON) pg = &UI_PAGES[g_page];
+      }
+
+      if (!pg){
+        /* 控制台：进页时整屏画一次，之后新行由 Console_Push 直接画一页并硬件滚动 */
+        if (!Console_IsShown()){ Console_Show(); shown = NULL; }
+      }else{
+        if (Console_IsShown()) Console_Hide();        /* 起始行归 0，下面整页重画 */
+        if (pg != shown){ UI_Show(pg); shown = pg; }   /* 换页：清屏整页重画 */
+        else            { UI_Render(pg); }
       }
 
-      SSD1306_Update();
-      next_oled_ms = now + OLED_REFRESH_MS;
+      SSD1306_UpdateAsync();   // DMA 后台发送，且只发变化的区域
+      UI_RefreshDone(now);
     }
 
     HAL_Delay(5);
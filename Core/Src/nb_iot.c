@@ -3,122 +3,404 @@
 #include <stdio.h>
 
 /* 使用 USART1 与 BC260Y-CN 通讯（与你原工程一致） */
-NB_State_t g_nb = {0,0};
+NB_State_t g_nb = {0, 0, 0, 99};
 
-/* ---- 串口基础 ---- */
-static int uart_send_str(const char* s){
-  if(!s) return -1;
-  return (HAL_UART_Transmit(&huart1,(uint8_t*)s,strlen(s),500)==HAL_OK)?0:-1;
-}
-static int uart_send_bytes(const uint8_t* b, uint16_t n){
-  return (HAL_UART_Transmit(&huart1,(uint8_t*)b,n,1000)==HAL_OK)?0:-1;
+static NB_LogHook s_log = NULL;
+void NB_SetLogHook(NB_LogHook fn){ s_log = fn; }
+
+/* ---- 收行 ---- */
+/* 字节从 USART1 接收环形缓冲（DMA 后台收）里取，拼进 s_line。没收完的半行留着下次接着拼，
+ * 所以不用等待。发数据前模组回的提示符 “> ” 后面没有换行，单独作为一行 “>” 返回。
+ * 环形缓冲是循环 DMA 一直在写的，行还可能跨过缓冲末尾，所以这里拷一次；之后的切字段都在 s_line 上原地做。 */
+static char s_line[160];
+static int  s_line_len = 0;
+
+/* 拼出一整行就返回 s_line（调用方可原地改写，下次调用前有效）；还没有整行返回 NULL */
+static char* rx_line(void){
+  int c;
+  while ((c = UART1_RxGetc()) >= 0){
+    if (c == '\r' || c == '\n'){
+      if (s_line_len == 0) continue;          // 跳过连续\r\n
+      s_line[s_line_len] = 0;
+      s_line_len = 0;
+      return s_line;
+    }
+    if (s_line_len == 0 && c == ' ') continue; // 提示符后的空格
+    if (s_line_len == 0 && c == '>'){ s_line[0] = '>'; s_line[1] = 0; return s_line; }
+    if (s_line_len < (int)sizeof(s_line) - 1) s_line[s_line_len++] = (char)c;
+  }
+  return NULL;
 }
 
-/* 非阻塞读一行：以 \\r 或 \\n 结束，超时返回已读长度（可为 0） */
 int NB_ReadLine(char* out, int max, uint32_t tout_ms){
   if(!out || max<=1) return -1;
   uint32_t t0 = HAL_GetTick();
-  int i = 0;
-  while ((HAL_GetTick() - t0) < tout_ms){
-    uint8_t ch;
-    if (HAL_UART_Receive(&huart1, &ch, 1, 10) == HAL_OK){
-      if(ch=='\\r' || ch=='\\n'){
-        if(i==0) continue; // 跳过连续\\r\\n
-        break;
-      }
-      if(i < max-1) out[i++] = (char)ch;
+  do {
+    const char* l = rx_line();
+    if (l){
+      int n = (int)strlen(l);
+      if (n > max - 1) n = max - 1;
+      memcpy(out, l, (size_t)n);
+      out[n] = 0;
+      return n;
     }
-  }
-  out[i] = 0;
-  return i;
+  } while ((HAL_GetTick() - t0) < tout_ms);
+  out[0] = 0;
+  return 0;
 }
 
-/* 等待 AT 返回中包含某子串（或 ERROR），并支持收集回显 */
-static int at_wait(const char* expect, uint32_t tout_ms, char* echo, int echo_sz){
-  char line[160]; line[0]=0;
-  uint32_t t0 = HAL_GetTick();
-  while ((HAL_GetTick() - t0) < tout_ms){
-    int n = NB_ReadLine(line, sizeof(line), 200);
-    if(n <= 0) continue;
-    if(echo && echo_sz>0){
-      strncat(echo, line, echo_sz-1);
-      strncat(echo, "\\n",  echo_sz-1);
+/* ---- 字段解析（原地切分，不拷贝、不用 sscanf） ---- */
+int NB_SplitFields(char* s, char* f[], int max){
+  int n = 0;
+  if (!s || max <= 0) return 0;
+  for (;;){
+    while (*s == ' ') s++;
+    if (*s == '"'){                             /* 引号串：去掉两头引号，内容里的逗号不算分隔 */
+      f[n++] = ++s;
+      while (*s && *s != '"') s++;
+      if (*s) *s++ = 0;
+      while (*s && *s != ',') s++;
+    } else {
+      f[n++] = s;
+      while (*s && *s != ',') s++;
     }
-    if (strstr(line, expect))  return 0;
-    if (strstr(line, "ERROR")) return -2;
-    if (strstr(line, "+CME ERROR")) return -3;
+    if (!*s || n == max) break;
+    *s++ = 0;
   }
-  return -4; // timeout
+  if (*s == ',') *s = 0;                        /* 字段数到上限：剩下的不要 */
+  return n;
 }
-static int at_cmd(const char* cmd, const char* expect, uint32_t tout_ms){
-  static const char crlf[] = "\\r\\n";
-  (void)uart_send_str(cmd);
-  (void)uart_send_bytes((const uint8_t*)crlf,2);
-  return at_wait(expect, tout_ms, NULL, 0);
+
+const char* NB_ParseInt(const char* s, int32_t* v){
+  uint8_t neg = 0;
+  int32_t x = 0;
+  if (!s) return NULL;
+  while (*s == ' ') s++;
+  if (*s == '-' || *s == '+') neg = (uint8_t)(*s++ == '-');
+  if (*s < '0' || *s > '9') return NULL;
+  for (; *s >= '0' && *s <= '9'; ++s){
+    int32_t d = *s - '0';
+    x = (x > (INT32_MAX - d) / 10) ? INT32_MAX : x * 10 + d;           /* 溢出就饱和 */
+  }
+  if (v) *v = neg ? -x : x;
+  return s;
 }
 
-/* 打开 UDP：Socket id=1，profile=1（BC260Y/Quectel 风格） */
-static int nb_open_udp(const char* ip, uint16_t port){
-  char cmd[112];
-  (void)at_cmd("AT+QICLOSE=1","OK",1000);  // 先尝试关闭旧的，不影响
-  snprintf(cmd,sizeof(cmd),"AT+QIOPEN=1,1,\\"UDP\\",\\"%s\\",%u,0,0,0", ip, (unsigned)port);
-  if (at_cmd(cmd,"OK",3000) != 0) return -1;
-  /* 等待 +QIOPEN: 1,0 表示 socket 1 打开成功 */
-  if (at_wait("+QIOPEN: 1,0", 10000, NULL, 0) != 0) return -2;
-  g_nb.opened = 1;
+/* ---- AT 命令引擎 ----
+ * 命令排队逐条执行：发出命令 → 等期望回复 / ERROR / 超时 → 调完成回调 → 下一条。
+ * 发送用 HAL_UART_Transmit_IT，接收从环形缓冲拼行，主循环每圈调 NB_Poll() 推进，哪一步都不原地等。
+ * 命令文本（含 \r\n）和 “>” 后要发的数据（含结尾 0x1A）拷进 s_at_buf，按排队顺序紧挨着放，
+ * 队首做完后把后面的整体前移，所以队首总在 s_at_buf[0]。 */
+typedef struct {
+  const char* expect;      /* 期望回复的行首（须是常量字符串） */
+  NB_AtDone   done;
+  void*       ctx;
+  uint32_t    tout_ms;
+  uint16_t    cmd_len;     /* 0=不发命令，只等回复（如 +QIOPEN 上报） */
+  uint16_t    data_len;    /* 0=没有数据段 */
+} nb_at_t;
+
+enum { AT_IDLE = 0, AT_WAIT, AT_PROMPT, AT_DATA };   /* 队首状态：未发 / 等回复 / 收到 “>” 待发数据 / 数据已发 */
+
+static nb_at_t  s_q[NB_AT_QUEUE];
+static uint8_t  s_q_head = 0, s_q_cnt = 0;
+static uint8_t  s_at_buf[NB_AT_BUF];
+static uint16_t s_at_used = 0;
+static uint8_t  s_at_state = AT_IDLE;
+static uint32_t s_at_t0 = 0;
+
+/* 发出去的命令/数据记日志（去掉结尾的 \r\n、0x1A） */
+static void at_log_out(const uint8_t* p, uint16_t n){
+  char tmp[128];
+  if (!s_log) return;
+  while (n && (p[n-1] == '\r' || p[n-1] == '\n' || p[n-1] == 0x1A)) n--;
+  if (n > sizeof(tmp) - 1) n = sizeof(tmp) - 1;
+  memcpy(tmp, p, n);
+  tmp[n] = 0;
+  s_log('>', tmp);
+}
+
+static uint8_t uart_tx_idle(void){ return huart1.gState == HAL_UART_STATE_READY; }
+
+int NB_AtQueue(const char* cmd, const char* expect, uint32_t tout_ms,
+               const uint8_t* data, uint16_t data_len, NB_AtDone done, void* ctx){
+  uint16_t cl = cmd ? (uint16_t)strlen(cmd) : 0;
+  uint16_t need = (uint16_t)((cl ? cl + 2 : 0) + (data_len ? data_len + 1 : 0));
+  if (s_q_cnt >= NB_AT_QUEUE || need > NB_AT_BUF - s_at_used) return NB_AT_FULL;
+
+  nb_at_t* a = &s_q[(s_q_head + s_q_cnt) % NB_AT_QUEUE];
+  uint8_t* w = &s_at_buf[s_at_used];
+  a->expect = expect; a->done = done; a->ctx = ctx; a->tout_ms = tout_ms;
+  a->cmd_len = 0; a->data_len = 0;
+  if (cl){
+    memcpy(w, cmd, cl); w[cl] = '\r'; w[cl+1] = '\n';
+    a->cmd_len = (uint16_t)(cl + 2);
+  }
+  if (data_len){
+    memcpy(&w[a->cmd_len], data, data_len); w[a->cmd_len + data_len] = 0x1A;
+    a->data_len = (uint16_t)(data_len + 1);
+  }
+  s_at_used = (uint16_t)(s_at_used + need);
+  s_q_cnt++;
   return 0;
 }
 
-/* ---- 初始化（最小必需流程） ---- */
-int NB_Init(const char* apn, const char* ip, uint16_t port){
-  if(!apn || !*apn || !ip || !*ip) return -1;
+uint8_t NB_AtPending(void){ return s_q_cnt; }
+
+/* 队首结束：先出队、腾出缓冲，再调回调（回调里可以接着排下一条） */
+static void at_finish(int res){
+  nb_at_t a = s_q[s_q_head];
+  uint16_t n = (uint16_t)(a.cmd_len + a.data_len);
+  if (!uart_tx_idle()) (void)HAL_UART_AbortTransmit(&huart1);   /* 超时时可能还没发完 */
+  memmove(s_at_buf, &s_at_buf[n], s_at_used - n);
+  s_at_used = (uint16_t)(s_at_used - n);
+  s_q_head = (uint8_t)((s_q_head + 1) % NB_AT_QUEUE);
+  s_q_cnt--;
+  s_at_state = AT_IDLE;
+  if (a.done) a.done(res, a.ctx);
+}
 
-  /* 1) 基础握手 */
-  if (at_cmd("AT","OK",1000) != 0){
-    (void)at_cmd("AT","OK",1500); // 部分固件第一次慢
+/* 推进队首：发命令、收到 “>” 后发数据；串口还在发上一段就等下一圈 */
+static void at_kick(void){
+  if (!s_q_cnt) return;
+  nb_at_t* a = &s_q[s_q_head];
+  if (s_at_state == AT_IDLE){
+    if (a->cmd_len){
+      if (!uart_tx_idle() || HAL_UART_Transmit_IT(&huart1, s_at_buf, a->cmd_len) != HAL_OK) return;
+      at_log_out(s_at_buf, a->cmd_len);
+    }
+    s_at_state = AT_WAIT;
+    s_at_t0 = HAL_GetTick();
+  } else if (s_at_state == AT_PROMPT){
+    if (!uart_tx_idle() || HAL_UART_Transmit_IT(&huart1, &s_at_buf[a->cmd_len], a->data_len) != HAL_OK) return;
+    at_log_out(&s_at_buf[a->cmd_len], a->data_len);
+    s_at_state = AT_DATA;
   }
+}
+
+/* 行首是否为 key（比 strstr 全行扫描便宜，也不会把 “SEND OK” 当成 “OK”） */
+static uint8_t starts_with(const char* line, const char* key){
+  while (*key) if (*line++ != *key++) return 0;
+  return 1;
+}
 
-  /* 2) 全功能 + 网络附着 */
-  (void)at_cmd("AT+CFUN=1","OK",2500);
-  (void)at_cmd("AT+CGATT=1","OK",8000);
+/* 队首命令的结果码：只看行首 */
+static void at_on_line(const char* line){
+  if (!s_q_cnt || s_at_state == AT_IDLE) return;
+  nb_at_t* a = &s_q[s_q_head];
+  if (s_at_state == AT_WAIT && a->data_len && line[0] == '>' && !line[1]){ s_at_state = AT_PROMPT; return; }
+  if      (a->expect && starts_with(line, a->expect)) at_finish(NB_AT_OK);
+  else if (starts_with(line, "+CME ERROR"))           at_finish(NB_AT_CME);
+  else if (starts_with(line, "ERROR") || starts_with(line, "SEND FAIL")) at_finish(NB_AT_ERROR);
+}
 
-  /* 3) 设置 PDP（APN） */
-  char cmd[96];
-  snprintf(cmd,sizeof(cmd),"AT+CGDCONT=1,\\"IP\\",\\"%s\\"", apn);
-  if (at_cmd(cmd,"OK",2000) != 0) return -2;
+/* ---- 主动上报（URC）与带参数的回复：按 “+XXX:” 前缀查表分发 ----
+ * 不管有没有命令在等，收到就更新 g_nb；表按前缀字典序排好，二分查找。
+ * 处理函数拿到的是原地切好的字段（引号已去掉）。 */
+#define NB_URC_MAX_FIELDS  6
 
-  /* 可选：查询注册与信号，便于调试 */
-  (void)at_cmd("AT+CEREG?","OK",1000);
-  (void)at_cmd("AT+CSQ","OK",1000);
+static NB_RecvHook s_recv = NULL;
+static uint8_t     s_rd_pending = 0;           /* 刚收到 +QIRD: <长度>，下一行是数据 */
 
-  /* 4) 打开 UDP */
-  if (nb_open_udp(ip, port) != 0) return -3;
+void NB_SetRecvHook(NB_RecvHook fn){ s_recv = fn; }
 
-  g_nb.inited = 1;
-  return 0;
+/* +CEREG: <stat>（上报，带位置信息时 4 个以上字段）或 +CEREG: <n>,<stat>（AT+CEREG? 的回复） */
+static void urc_cereg(char* f[], int n){
+  int32_t v;
+  if (NB_ParseInt(f[n == 2 ? 1 : 0], &v)) g_nb.reg = (uint8_t)v;
+}
+
+/* +CSQ: <rssi>,<ber> */
+static void urc_csq(char* f[], int n){
+  int32_t v;
+  (void)n;
+  if (NB_ParseInt(f[0], &v)) g_nb.csq = (uint8_t)v;
+}
+
+/* +QIOPEN: <id>,<err> */
+static void urc_qiopen(char* f[], int n){
+  int32_t id, err;
+  if (n < 2 || !NB_ParseInt(f[0], &id) || !NB_ParseInt(f[1], &err) || id != 1) return;
+  g_nb.opened = (err == 0);
+}
+
+/* +QIRD: <长度>（AT+QIRD 的回复，后面一行是数据） */
+static void urc_qird(char* f[], int n){
+  int32_t len;
+  (void)n;
+  s_rd_pending = (NB_ParseInt(f[0], &len) && len > 0);
+}
+
+/* +QIURC: "recv",<id>[,<长度>,<数据>] / "closed",<id> */
+static void urc_qiurc(char* f[], int n){
+  int32_t id;
+  if (n < 2 || !NB_ParseInt(f[1], &id) || id != 1) return;
+  if (!strcmp(f[0], "closed")){ g_nb.opened = 0; return; }
+  if (strcmp(f[0], "recv")) return;
+  if (n >= 4){                                  /* 直推模式：数据就在这一行 */
+    if (s_recv) s_recv(f[3], (int)strlen(f[3]));
+  } else {                                      /* 缓存模式（AT+QIOPEN 的 access_mode=0）：去读出来 */
+    (void)NB_AtQueue("AT+QIRD=1,512", "OK", 1000, NULL, 0, NULL, NULL);
+  }
+}
+
+typedef void (*nb_urc_fn)(char* f[], int n);
+static const struct { const char* key; nb_urc_fn fn; } k_urc[] = {   /* 按 key 字典序 */
+  { "+CEREG",  urc_cereg  },
+  { "+CSQ",    urc_csq    },
+  { "+QIOPEN", urc_qiopen },
+  { "+QIRD",   urc_qird   },
+  { "+QIURC",  urc_qiurc  },
+};
+
+static void urc_dispatch(char* line){
+  if (line[0] != '+') return;
+  char* colon = strchr(line, ':');
+  if (!colon) return;
+  size_t klen = (size_t)(colon - line);
+  int lo = 0, hi = (int)(sizeof(k_urc) / sizeof(k_urc[0])) - 1;
+  while (lo <= hi){
+    int mid = (lo + hi) / 2;
+    const char* key = k_urc[mid].key;
+    int c = strncmp(key, line, klen);
+    if (c == 0 && key[klen]) c = 1;              /* key 比行里的前缀长 */
+    if (c < 0) lo = mid + 1;
+    else if (c > 0) hi = mid - 1;
+    else {
+      char* f[NB_URC_MAX_FIELDS];
+      int n = NB_SplitFields(colon + 1, f, NB_URC_MAX_FIELDS);
+      k_urc[mid].fn(f, n);
+      return;
+    }
+  }
+}
+
+void NB_Poll(void){
+  char* line;
+  at_kick();
+  while ((line = rx_line()) != NULL){
+    if (s_log) s_log('<', line);
+    if (s_rd_pending){                          /* AT+QIRD 读出的数据行 */
+      s_rd_pending = 0;
+      if (s_recv) s_recv(line, (int)strlen(line));
+      continue;
+    }
+    at_on_line(line);                           /* 先按整行看结果码，再原地切字段分发 */
+    urc_dispatch(line);
+    at_kick();
+  }
+  if (s_q_cnt && s_at_state != AT_IDLE && (HAL_GetTick() - s_at_t0) >= s_q[s_q_head].tout_ms)
+    at_finish(NB_AT_TIMEOUT);
+  at_kick();
+}
+
+/* 阻塞版接口用：回调把结果写回调用方栈上的变量 */
+static void at_sync_done(int res, void* ctx){ *(volatile int*)ctx = res; }
+
+/* ---- 初始化（最小必需流程），每步的完成回调排下一步 ---- */
+enum { NBI_AT, NBI_AT2, NBI_CFUN, NBI_CGATT, NBI_PDP, NBI_CEREG, NBI_CSQ,
+       NBI_CLOSE, NBI_OPEN, NBI_OPENED, NBI_DONE };
+
+static char     s_apn[32], s_ip[64];
+static uint16_t s_port;
+static volatile int8_t s_init_res = -1;         /* 1=进行中，0=成功，<0=失败（未初始化也算 -1） */
+
+static void nb_init_issue(uint8_t step);
+
+static void nb_init_done(int res, void* ctx){
+  uint8_t step = (uint8_t)(uintptr_t)ctx;
+  switch (step){
+    case NBI_AT:     if (res == 0) step = NBI_AT2; break;        /* 第一次就 OK，不用再握手 */
+    case NBI_PDP:    if (res != 0){ s_init_res = -2; return; } break;
+    case NBI_OPEN:   if (res != 0){ s_init_res = -3; return; } break;
+    case NBI_OPENED: if (res != 0){ s_init_res = -3; return; } g_nb.opened = 1; break;
+    default: break;                                             /* 其余步骤失败不影响 */
+  }
+  if (++step == NBI_DONE){ g_nb.inited = 1; s_init_res = 0; return; }
+  nb_init_issue(step);
+}
+
+static void nb_init_issue(uint8_t step){
+  char cmd[112];
+  const char* c = cmd;
+  const char* expect = "OK";
+  uint32_t tout = 1000;
+  switch (step){
+    case NBI_AT:     c = "AT"; break;
+    case NBI_AT2:    c = "AT"; tout = 1500; break;                /* 部分固件第一次慢 */
+    case NBI_CFUN:   c = "AT+CFUN=1"; tout = 2500; break;         /* 全功能 + 网络附着 */
+    case NBI_CGATT:  c = "AT+CGATT=1"; tout = 8000; break;
+    case NBI_PDP:    snprintf(cmd, sizeof(cmd), "AT+CGDCONT=1,\"IP\",\"%s\"", s_apn); tout = 2000; break;
+    case NBI_CEREG:  c = "AT+CEREG?"; break;                      /* 查询注册与信号，便于调试 */
+    case NBI_CSQ:    c = "AT+CSQ"; break;
+    case NBI_CLOSE:  c = "AT+QICLOSE=1"; break;                   /* 先尝试关闭旧的，不影响 */
+    case NBI_OPEN:   /* UDP：Socket id=1，profile=1（BC260Y/Quectel 风格） */
+      snprintf(cmd, sizeof(cmd), "AT+QIOPEN=1,1,\"UDP\",\"%s\",%u,0,0,0", s_ip, (unsigned)s_port);
+      tout = 3000; break;
+    case NBI_OPENED: c = NULL; expect = "+QIOPEN: 1,0"; tout = 10000; break;   /* 等 socket 1 打开成功 */
+    default: return;
+  }
+  if (NB_AtQueue(c, expect, tout, NULL, 0, nb_init_done, (void*)(uintptr_t)step) < 0) s_init_res = -4;
+}
+
+int NB_InitAsync(const char* apn, const char* ip, uint16_t port){
+  if(!apn || !*apn || !ip || !*ip) return -1;
+  if (s_init_res == 1) return -5;                                 /* 上一次还没走完 */
+  strncpy(s_apn, apn, sizeof(s_apn)-1); s_apn[sizeof(s_apn)-1] = 0;
+  strncpy(s_ip,  ip,  sizeof(s_ip)-1);  s_ip[sizeof(s_ip)-1]   = 0;
+  s_port = port;
+  g_nb.inited = 0; g_nb.opened = 0;
+  s_init_res = 1;
+  nb_init_issue(NBI_AT);
+  return (s_init_res < 0) ? s_init_res : 0;
+}
+
+int NB_InitResult(void){ return s_init_res; }
+
+int NB_Init(const char* apn, const char* ip, uint16_t port){
+  int rc = NB_InitAsync(apn, ip, port);
+  if (rc < 0) return rc;
+  while (s_init_res == 1) NB_Poll();
+  return s_init_res;
 }
 
 /* ---- 发送一行数据到 UDP ---- */
-int NB_SendLine(const char* line){
+int NB_SendLineAsync(const char* line, NB_AtDone done, void* ctx){
   if(!line || !*line) return -1;
   if(!g_nb.inited || !g_nb.opened) return -2;
 
-  char cmd[48];
-  char payload[300];
+  char cmd[24];
+  uint8_t payload[NB_LINE_MAX + 2];
   size_t L = strlen(line);
-  if (L > sizeof(payload)-3) L = sizeof(payload)-3;
+  if (L > NB_LINE_MAX) L = NB_LINE_MAX;
   memcpy(payload, line, L);
-  payload[L++] = '\\r';
-  payload[L++] = '\\n';
-  payload[L]   = 0;
+  payload[L++] = '\r';
+  payload[L++] = '\n';
 
-  snprintf(cmd,sizeof(cmd),"AT+QISEND=1,%u", (unsigned)L);
-  if (at_cmd(cmd,">",2000) != 0) return -3;
+  /* 命令发出后等 “>” 再发数据，最后等 SEND OK（数据段后的 0x1A 由 NB_AtQueue 补） */
+  snprintf(cmd, sizeof(cmd), "AT+QISEND=1,%u", (unsigned)L);
+  return NB_AtQueue(cmd, "SEND OK", 7000, payload, (uint16_t)L, done, ctx);
+}
 
-  (void)uart_send_bytes((uint8_t*)payload, (uint16_t)L);
-  uint8_t ctrlz = 0x1A;
-  (void)uart_send_bytes(&ctrlz,1);
+int NB_SendBinAsync(const uint8_t* p, uint16_t n, NB_AtDone done, void* ctx){
+  static const char HEX[] = "0123456789ABCDEF";
+  if(!p || !n || n > NB_BIN_MAX) return -1;
+  if(!g_nb.inited || !g_nb.opened) return -2;
 
-  if (at_wait("SEND OK", 5000, NULL, 0) != 0) return -4;
-  return 0;
+  char cmd[24 + 2 * NB_BIN_MAX + 1];
+  int k = snprintf(cmd, sizeof(cmd), "AT+QISENDEX=1,%u,", (unsigned)n);
+  for (uint16_t i = 0; i < n; ++i){
+    cmd[k++] = HEX[p[i] >> 4];
+    cmd[k++] = HEX[p[i] & 15];
+  }
+  cmd[k] = 0;
+  return NB_AtQueue(cmd, "SEND OK", 5000, NULL, 0, done, ctx);
+}
+
+int NB_SendLine(const char* line){
+  volatile int res = 1;
+  int rc = NB_SendLineAsync(line, at_sync_done, (void*)&res);
+  if (rc < 0) return rc;
+  while (res == 1) NB_Poll();
+  return (res == 0) ? 0 : -4;
 }
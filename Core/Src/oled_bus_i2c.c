@@ -0,0 +1,38 @@
+#include "oled_bus.h"
+
+#if SSD1306_BUS == SSD1306_BUS_I2C
+#include "i2c.h"
+
+/* I2C 传输：I2C1 400kHz（PB8=SCL、PB9=SDA），I2C1_TX DMA=DMA1_Channel6（i2c.c）。
+ * 每段是一次 I2C 写：地址 + 控制字节（0x00 后跟命令串，0x40 后跟显存），
+ * 控制字节借 HAL 的 Mem 接口当 8 位“寄存器地址”发出，数据段不用另拷一份加前缀。 */
+#define OLED_I2C_DEV      ((uint16_t)(SSD1306_I2C_ADDR << 1))
+#define OLED_I2C_CTRL(d)  ((uint16_t)((d) ? 0x40 : 0x00))
+#define OLED_I2C_TIMEOUT  100u     /* ms；整页 128 字节在 400kHz 下约 3ms */
+
+void OLED_Bus_Reset(void){ HAL_Delay(10); }   /* 模块多为 4 脚，复位由板上 RC 完成，这里只等它稳定 */
+
+void OLED_Bus_Begin(void){}
+
+void OLED_Bus_End(void){}
+
+HAL_StatusTypeDef OLED_Bus_Write(uint8_t data, const uint8_t* p, uint16_t n){
+  return HAL_I2C_Mem_Write(&hi2c1, OLED_I2C_DEV, OLED_I2C_CTRL(data), I2C_MEMADD_SIZE_8BIT,
+                           (uint8_t*)p, n, OLED_I2C_TIMEOUT);
+}
+
+HAL_StatusTypeDef OLED_Bus_WriteDMA(uint8_t data, const uint8_t* p, uint16_t n){
+  return HAL_I2C_Mem_Write_DMA(&hi2c1, OLED_I2C_DEV, OLED_I2C_CTRL(data), I2C_MEMADD_SIZE_8BIT,
+                               (uint8_t*)p, n);
+}
+
+/* DMA 写完且 STOP 已发出（HAL 状态已回到 READY，可在回调里直接启动下一段） */
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c){
+  if (hi2c == &hi2c1) SSD1306_BusTxDone();
+}
+
+/* 无应答/仲裁丢失等：HAL 已中止本次传输 */
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c){
+  if (hi2c == &hi2c1) SSD1306_BusError();
+}
+#endif /* SSD1306_BUS_I2C */
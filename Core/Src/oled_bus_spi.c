@@ -0,0 +1,59 @@
+#include "oled_bus.h"
+
+#if SSD1306_BUS == SSD1306_BUS_SPI
+#include "stm32_init.h"
+#if SSD1306_USE_LL_CMD
+#include "stm32f1xx_ll_spi.h"
+#endif
+
+extern SPI_HandleTypeDef hspi1;
+
+/* SPI 传输：CS=PA4、DC=PB0、RST=PB1（stm32_init.h），SPI1_TX DMA=DMA1_Channel3（spi.c） */
+
+void OLED_Bus_Reset(void){ OLED_RST_L(); HAL_Delay(5); OLED_RST_H(); HAL_Delay(5); }
+
+void OLED_Bus_Begin(void){ OLED_CS_L(); }
+
+void OLED_Bus_End(void){ OLED_CS_H(); }
+
+#if SSD1306_USE_LL_CMD
+/* 短命令直接写 SPI 寄存器：省掉 HAL_SPI_Transmit 每次的加锁/状态检查/超时计时，
+ * 逐字节等 TXE 背靠背发出，最后等 BSY 清零再放 CS。 */
+static void oled_spi_ll_send(const uint8_t* p, uint16_t n){
+  SPI_TypeDef* spi = hspi1.Instance;
+  if (!LL_SPI_IsEnabled(spi)) LL_SPI_Enable(spi);
+  while (n--){
+    while (!LL_SPI_IsActiveFlag_TXE(spi)) {}
+    LL_SPI_TransmitData8(spi, *p++);
+  }
+  while (!LL_SPI_IsActiveFlag_TXE(spi)) {}
+  while (LL_SPI_IsActiveFlag_BSY(spi)) {}
+  LL_SPI_ClearFlag_OVR(spi);             /* 只发不收，全双工下 RX 溢出标志要清掉，免得影响后面的 HAL 传输 */
+}
+#endif
+
+HAL_StatusTypeDef OLED_Bus_Write(uint8_t data, const uint8_t* p, uint16_t n){
+  if (data){ OLED_DC_Data(); return HAL_SPI_Transmit(&hspi1, (uint8_t*)p, n, HAL_MAX_DELAY); }
+  OLED_DC_Cmd();
+#if SSD1306_USE_LL_CMD
+  oled_spi_ll_send(p, n);
+  return HAL_OK;
+#else
+  return HAL_SPI_Transmit(&hspi1, (uint8_t*)p, n, HAL_MAX_DELAY);
+#endif
+}
+
+HAL_StatusTypeDef OLED_Bus_WriteDMA(uint8_t data, const uint8_t* p, uint16_t n){
+  if (data) OLED_DC_Data(); else OLED_DC_Cmd();
+  return HAL_SPI_Transmit_DMA(&hspi1, (uint8_t*)p, n);
+}
+
+/* SPI1 DMA 发送完成（HAL 已等到 BSY 清零） */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi){
+  if (hspi == &hspi1) SSD1306_BusTxDone();
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi){
+  if (hspi == &hspi1) SSD1306_BusError();
+}
+#endif /* SSD1306_BUS_SPI */
@@ -0,0 +1,126 @@
+#include "oled_console.h"
+#include "ssd1306.h"
+#include <string.h>
+
+/* 历史：字节环 s_text 里按顺序存各行文本（不带结尾 0），
+ * s_off/s_len 记每行的起点和长度（行号按 CONSOLE_MAX_LINES 取模）。
+ * s_total 是累计行数，行的“序号”从 0 递增；现存的是 [s_total-s_count, s_total)。 */
+static char     s_text[CONSOLE_TEXT_BYTES];
+static uint16_t s_off[CONSOLE_MAX_LINES];
+static uint8_t  s_len[CONSOLE_MAX_LINES];
+static uint16_t s_wr;          /* 字节环写指针 */
+static uint16_t s_used;        /* 字节环已用 */
+static uint8_t  s_count;
+static uint32_t s_total;
+
+/* 显示：s_top 是屏上第 0 行对应的帧缓冲页（起始行 = s_top*8），
+ * s_bottom 是最底一行显示的行序号 +1（= s_total 表示停在最新处，新行来了跟着滚） */
+static uint8_t  s_shown;
+static uint8_t  s_top;
+static uint32_t s_bottom;
+
+static void con_store(const char* s, uint8_t n){
+  if (n > CONSOLE_COLS) n = CONSOLE_COLS;
+  /* 行数或字节不够就丢最旧的行 */
+  while (s_count && (s_count >= CONSOLE_MAX_LINES || s_used + n > CONSOLE_TEXT_BYTES)){
+    uint8_t old = (uint8_t)((s_total - s_count) % CONSOLE_MAX_LINES);
+    s_used -= s_len[old];
+    s_count--;
+  }
+  uint8_t slot = (uint8_t)(s_total % CONSOLE_MAX_LINES);
+  s_off[slot] = s_wr;
+  s_len[slot] = n;
+  for (uint8_t i = 0; i < n; ++i){
+    s_text[s_wr] = s[i];
+    if (++s_wr >= CONSOLE_TEXT_BYTES) s_wr = 0;
+  }
+  s_used += n;
+  s_count++;
+  s_total++;
+}
+
+/* 取第 seq 行到 out（带结尾 0）；已丢弃或还没有的行返回空串 */
+static void con_line(uint32_t seq, char out[CONSOLE_COLS + 1]){
+  out[0] = 0;
+  if (seq >= s_total || seq < s_total - s_count) return;
+  uint8_t  slot = (uint8_t)(seq % CONSOLE_MAX_LINES);
+  uint16_t p = s_off[slot];
+  uint8_t  n = s_len[slot];
+  for (uint8_t i = 0; i < n; ++i){
+    out[i] = s_text[p];
+    if (++p >= CONSOLE_TEXT_BYTES) p = 0;
+  }
+  out[n] = 0;
+}
+
+/* 把第 seq 行画到帧缓冲第 page 页（物理位置，整页先清） */
+static void con_draw(uint8_t page, uint32_t seq){
+  char l[CONSOLE_COLS + 1];
+  con_line(seq, l);
+  SSD1306_FillRect(0, page * 8, SSD1306_WIDTH, 8, 0);
+  if (l[0]) SSD1306_DrawString(0, page * 8, l);
+}
+
+/* 一行新文本已入库：停在最新处就把滚出去的顶行改画成新行，再滚一行 */
+static void con_follow(void){
+  if (!s_shown || s_bottom != s_total - 1) return;
+  con_draw(s_top, s_total - 1);
+  s_top = (uint8_t)((s_top + 1) & (CONSOLE_ROWS - 1));
+  s_bottom = s_total;
+  SSD1306_SetStartLine((uint8_t)(s_top * 8));
+}
+
+void Console_Push(const char* s){
+  if (!s) return;
+  do {
+    uint8_t n = 0;
+    while (s[n] && s[n] != '\n' && s[n] != '\r' && n < CONSOLE_COLS) n++;
+    con_store(s, n);
+    con_follow();
+    s += n;
+    while (*s == '\n' || *s == '\r') s++;
+  } while (*s);
+}
+
+void Console_PushTagged(char tag, const char* s){
+  char l[CONSOLE_COLS * 3 + 2];            /* 最多占 3 行，再长的截掉 */
+  l[0] = tag;
+  strncpy(&l[1], s ? s : "", sizeof(l) - 2);
+  l[sizeof(l) - 1] = 0;
+  Console_Push(l);
+}
+
+void Console_Show(void){
+  s_shown  = 1;
+  s_top    = 0;
+  s_bottom = s_total;
+  for (uint8_t r = 0; r < CONSOLE_ROWS; ++r){   /* 不满一屏时上面几行留空 */
+    con_draw(r, (s_bottom + r >= CONSOLE_ROWS) ? s_bottom + r - CONSOLE_ROWS : UINT32_MAX);
+  }
+  SSD1306_SetStartLine(0);
+}
+
+void Console_Hide(void){
+  s_shown = 0;
+  SSD1306_SetStartLine(0);
+}
+
+uint8_t Console_IsShown(void){ return s_shown; }
+
+uint8_t Console_PageUp(void){
+  if (!s_shown) return 0;
+  uint32_t oldest = s_total - s_count;
+  uint32_t min_bottom = oldest + CONSOLE_ROWS;         /* 最早一屏 */
+  if (s_count <= CONSOLE_ROWS || s_bottom <= min_bottom) return 0;
+
+  uint32_t nb = (s_bottom - min_bottom > CONSOLE_PAGE_STEP) ? s_bottom - CONSOLE_PAGE_STEP : min_bottom;
+  uint8_t  k  = (uint8_t)(s_bottom - nb);
+  /* 往下滚 k 行：原来的底部 k 页变成新的顶部 k 行，画上更早的内容 */
+  s_top = (uint8_t)((s_top - k) & (CONSOLE_ROWS - 1));
+  for (uint8_t r = 0; r < k; ++r){
+    con_draw((uint8_t)((s_top + r) & (CONSOLE_ROWS - 1)), nb - CONSOLE_ROWS + r);
+  }
+  s_bottom = nb;
+  SSD1306_SetStartLine((uint8_t)(s_top * 8));
+  return 1;
+}
@@ -0,0 +1,179 @@
+#include "oled_snap.h"
+#include "ssd1306.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SNAP_FB_BYTES  (SSD1306_WIDTH * SSD1306_PAGES)
+#define SNAP_MAX_SKIP  64
+#define SNAP_MAX_LIT   64
+#define SNAP_MIN_COPY  3
+#define SNAP_MAX_COPY  (0x1F + SNAP_MIN_COPY)
+#define SNAP_MAX_OFF   1024
+
+static uint8_t s_ref[SNAP_FB_BYTES];      /* 上一张发出的画面（D 帧基准） */
+static uint8_t s_ref_ok = 0;              /* 0=没有可用基准，下一张发关键帧 */
+static uint8_t s_seq = 0;
+
+/* 正在分行发出的这一张：画面冻结一份（发送途中屏幕还在变），每发一行重新编码一遍取出那一块 */
+static uint8_t  s_cur[SNAP_FB_BYTES];
+static uint8_t  s_next = 0, s_cnt = 0;    /* 下一行的块号 / 总块数；相等即没有待发的行 */
+static uint8_t  s_start;
+static char     s_type;
+static uint16_t s_crc;
+
+/* 输出：攒满一块就编成一行，块号等于 want 的那一块交给 sink；sink=NULL 时只数字节（算块数用） */
+typedef struct {
+  Snap_LineSink sink;
+  uint16_t total;
+  uint8_t  n, idx, want;
+  int      res;
+  uint8_t  buf[SNAP_CHUNK_BYTES];
+} snap_out_t;
+
+static char s_line[32 + (SNAP_CHUNK_BYTES + 2) / 3 * 4 + 1];
+
+static const char B64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static char* b64_encode(char* o, const uint8_t* p, uint16_t n){
+  for (; n >= 3; n -= 3, p += 3){
+    uint32_t v = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+    *o++ = B64[v >> 18]; *o++ = B64[(v >> 12) & 63]; *o++ = B64[(v >> 6) & 63]; *o++ = B64[v & 63];
+  }
+  if (n){
+    uint32_t v = ((uint32_t)p[0] << 16) | ((n > 1) ? ((uint32_t)p[1] << 8) : 0);
+    *o++ = B64[v >> 18]; *o++ = B64[(v >> 12) & 63];
+    *o++ = (n > 1) ? B64[(v >> 6) & 63] : '=';
+    *o++ = '=';
+  }
+  *o = 0;
+  return o;
+}
+
+static void out_flush(snap_out_t* o){
+  if (!o->n) return;
+  if (o->sink && o->idx == o->want){
+    int k = snprintf(s_line, sizeof(s_line), "FB,%u,%c,%u/%u,%u,%04X,", (unsigned)s_seq, s_type,
+                     (unsigned)(o->idx + 1), (unsigned)s_cnt, (unsigned)s_start, (unsigned)s_crc);
+    b64_encode(&s_line[k], o->buf, o->n);
+    o->res = o->sink(s_line);
+  }
+  o->idx++;
+  o->n = 0;
+}
+
+static void out_put(snap_out_t* o, uint8_t b){
+  o->buf[o->n++] = b;
+  o->total++;
+  if (o->n == SNAP_CHUNK_BYTES) out_flush(o);
+}
+
+static void out_lit(snap_out_t* o, const uint8_t* p, uint16_t n){
+  while (n){
+    uint8_t k = (uint8_t)((n > SNAP_MAX_LIT) ? SNAP_MAX_LIT : n);
+    out_put(o, (uint8_t)(0x40 | (k - 1)));
+    for (uint8_t i = 0; i < k; ++i) out_put(o, p[i]);
+    p += k; n -= k;
+  }
+}
+
+/* 贪心编码：同上一张的连续字节记跳过；否则在本帧前 1024 字节里找最长重复段（≥3 才用），
+ * 都不行的字节攒成原值段。找重复段是暴力比较，只在截屏时跑；要的那一块编完就停。 */
+static void snap_encode(const uint8_t* cur, const uint8_t* ref, snap_out_t* o){
+  uint16_t i = 0, lit = 0;
+  while (i < SNAP_FB_BYTES){
+    if (o->idx > o->want) return;
+    if (cur[i] == ref[i]){
+      uint16_t n = 1;
+      while (i + n < SNAP_FB_BYTES && n < SNAP_MAX_SKIP && cur[i + n] == ref[i + n]) n++;
+      out_lit(o, &cur[i - lit], lit); lit = 0;
+      out_put(o, (uint8_t)(n - 1));
+      i += n;
+      continue;
+    }
+    uint16_t best = 0, best_off = 0;
+    uint16_t max_off = (i < SNAP_MAX_OFF) ? i : SNAP_MAX_OFF;
+    for (uint16_t off = 1; off <= max_off; ++off){
+      const uint8_t* s = &cur[i - off];
+      if (s[0] != cur[i]) continue;
+      uint16_t l = 1;
+      while (l < SNAP_MAX_COPY && i + l < SNAP_FB_BYTES && s[l] == cur[i + l]) l++;
+      if (l > best){ best = l; best_off = off; if (l == SNAP_MAX_COPY) break; }
+    }
+    if (best >= SNAP_MIN_COPY){
+      out_lit(o, &cur[i - lit], lit); lit = 0;
+      out_put(o, (uint8_t)(0x80 | ((best - SNAP_MIN_COPY) << 2) | ((best_off - 1) >> 8)));
+      out_put(o, (uint8_t)(best_off - 1));
+      i += best;
+      continue;
+    }
+    lit++; i++;
+  }
+  out_lit(o, &cur[i - lit], lit);
+  out_flush(o);
+}
+
+static uint16_t crc16_ccitt(const uint8_t* p, uint16_t n){
+  uint16_t crc = 0xFFFF;
+  while (n--){
+    crc ^= (uint16_t)(*p++ << 8);
+    for (uint8_t b = 0; b < 8; ++b) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+int Snap_ParseCommand(const char* line){
+  if (!line || !strncmp(line, "FB,", 3)) return -1;      /* 自己发出的截屏行（模组回显）不算 */
+  const char* p = strstr(line, "SNAP");
+  if (!p) return -1;
+  p += 4;
+  if (*p == ' ') p++;
+  return (*p == 'K' || *p == 'k') ? 1 : 0;
+}
+
+int Snap_Begin(uint8_t key){
+  if (s_next != s_cnt) s_ref_ok = 0;          /* 上一张没发完：主机那边没有完整基准 */
+  /* 取影子缓冲而不是绘图缓冲：发送途中日志钩子可能往绘图缓冲里画控制台新行，影子缓冲只在刷新时变 */
+  memcpy(s_cur, SSD1306_GetFrontBuffer(), sizeof(s_cur));
+  if (key || !s_ref_ok) memset(s_ref, 0, sizeof(s_ref));
+
+  s_type  = (key || !s_ref_ok) ? 'K' : 'D';
+  s_start = SSD1306_GetFrontStartLine();      /* 与影子缓冲同一帧；SetStartLine 后还没刷新的值不算 */
+  s_crc   = crc16_ccitt(s_cur, SNAP_FB_BYTES);
+
+  snap_out_t o;                                /* 先整张编一遍只数块数，行里要带 “块号/块数” */
+  memset(&o, 0, sizeof(o));
+  o.want = 0xFF;
+  snap_encode(s_cur, s_ref, &o);
+  s_cnt  = o.idx;
+  s_next = 0;
+  s_seq++;
+  return o.total;
+}
+
+uint8_t Snap_Pending(void){ return (uint8_t)(s_cnt - s_next); }
+
+int Snap_SendNext(Snap_LineSink sink){
+  if (s_next == s_cnt) return 0;
+  if (!sink) return -1;
+  snap_out_t o;
+  memset(&o, 0, sizeof(o));
+  o.sink = sink;
+  o.want = s_next;
+  snap_encode(s_cur, s_ref, &o);
+  if (o.res < 0) return o.res;                 /* 这一行留着，下次再发 */
+  if (++s_next == s_cnt){                      /* 整张发完才换基准 */
+    memcpy(s_ref, s_cur, sizeof(s_ref));
+    s_ref_ok = 1;
+  }
+  return s_cnt - s_next;
+}
+
+int Snap_Send(Snap_LineSink sink, uint8_t key){
+  if (!sink) return -1;
+  int bytes = Snap_Begin(key);
+  while (Snap_Pending())
+    if (Snap_SendNext(sink) < 0){ Snap_Reset(); return -1; }
+  return bytes;
+}
+
+void Snap_Reset(void){ s_ref_ok = 0; s_next = s_cnt; }
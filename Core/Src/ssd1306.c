@@ -1,20 +1,65 @@
 #include "ssd1306.h"
+#include "oled_bus.h"
 #include <string.h>
 
-extern SPI_HandleTypeDef hspi1;
+static uint8_t s_buf[SSD1306_WIDTH * SSD1306_PAGES];     /* 绘图缓冲（后台，应用随时可画） */
 
-static uint8_t s_buf[SSD1306_WIDTH * SSD1306_PAGES];
+/* 前台/影子缓冲：屏上当前显示的内容。刷新时逐页与 s_buf 比较，只把变化的列区间
+ * 拷过来并发送；DMA 模式下发送期间应用继续往 s_buf 画也不会撕裂正在发送的画面。 */
+static uint8_t s_front[SSD1306_WIDTH * SSD1306_PAGES];
+static uint8_t s_force_full = 1;                       /* 1=下次整屏重发（上电/出错后屏内容未知） */
 
-static void ssd1306_cmd(uint8_t cmd){
-  OLED_DC_Cmd(); OLED_CS_L();
-  HAL_SPI_Transmit(&hspi1, &cmd, 1, HAL_MAX_DELAY);
-  OLED_CS_H();
+#if SSD1306_CTRL == SSD1306_CTRL_SH1106
+#define SSD1306_WIN_CMD_LEN 3     /* 0xB0|页、列低半字节、列高半字节 */
+#else
+#define SSD1306_WIN_CMD_LEN 6     /* 0x21 列起止、0x22 页起止 */
+#endif
+
+/* 每页待发送的列窗口 [lo,hi]，lo>hi 表示该页没变化 */
+static uint8_t s_win_lo[SSD1306_PAGES];
+static uint8_t s_win_hi[SSD1306_PAGES];
+static SSD1306_Stats_t s_stats;
+
+/* 显示起始行（0x40|n）：屏上第 0 行显示 GDDRAM 的第 n 行。帧缓冲始终按 GDDRAM 物理位置存放，
+ * 改起始行就是整屏硬件滚动；新值在下一次刷新把显存发完之后才发出，避免先滚后画。 */
+static uint8_t s_start_line = 0;
+static uint8_t s_start_pending = 0;
+static uint8_t s_front_start = 0;     /* 与前台缓冲一同交出去的起始行（截屏用） */
+
+#if SSD1306_USE_DMA
+static volatile uint8_t s_busy = 0;                    /* 1=DMA 刷新进行中 */
+static uint8_t s_flush_page;                           /* 正在发送的页 */
+static uint8_t s_flush_phase;                          /* 0=下一步发窗口命令，1=下一步发显存 */
+static uint8_t s_win_cmd[SSD1306_WIN_CMD_LEN];         /* 当前页窗口命令（DMA 源，须常驻） */
+static uint8_t s_start_cmd;                            /* 起始行命令（DMA 源） */
+static uint8_t s_flush_start;                          /* 1=本帧末尾要发起始行命令 */
+static uint32_t s_flush_t0;                            /* 本帧开始发送时的 DWT 计数 */
+static SSD1306_FlushCallback s_flush_cb = NULL;
+#endif
+
+/* 命令列表：整串命令一次发完（SPI 一次 CS、一次 DC 切换；I2C 一次传输） */
+HAL_StatusTypeDef SSD1306_WriteCommands(const uint8_t* cmds, uint16_t len){
+  if (!cmds || !len) return HAL_ERROR;
+#if SSD1306_USE_DMA
+  if (SSD1306_WaitFlush(HAL_MAX_DELAY) != HAL_OK) return HAL_BUSY;   /* 不能在 DMA 发送中途插入命令 */
+#endif
+  uint32_t t0 = SSD1306_CYCCNT();
+  OLED_Bus_Begin();
+  HAL_StatusTypeDef st = OLED_Bus_Write(0, cmds, len);
+  OLED_Bus_End();
+  s_stats.busy_cycles += SSD1306_CYCCNT() - t0;
+  return st;
 }
+
+#if !SSD1306_USE_DMA
 static void ssd1306_data(const uint8_t* data, uint16_t len){
-  OLED_DC_Data(); OLED_CS_L();
-  HAL_SPI_Transmit(&hspi1, (uint8_t*)data, len, HAL_MAX_DELAY);
-  OLED_CS_H();
+  uint32_t t0 = SSD1306_CYCCNT();
+  OLED_Bus_Begin();
+  (void)OLED_Bus_Write(1, data, len);
+  OLED_Bus_End();
+  s_stats.busy_cycles += SSD1306_CYCCNT() - t0;
 }
+#endif
 
 /* 5x7 ASCII 字库（0x20~0x7E） */
 static const uint8_t FONT5x7[95][5] = {
@@ -53,6 +98,10 @@ static const uint8_t FONT5x7[95][5] = {
 /* 基础绘图与文本 */
 void SSD1306_Fill(uint8_t on){ memset(s_buf, on ? 0xFF : 0x00, sizeof(s_buf)); }
 
+uint8_t* SSD1306_GetBuffer(void){ return s_buf; }
+
+const uint8_t* SSD1306_GetFrontBuffer(void){ return s_front; }
+
 void SSD1306_DrawPixel(uint16_t x, uint16_t y, uint8_t on){
   if(x>=SSD1306_WIDTH || y>=SSD1306_HEIGHT) return;
   uint32_t idx = x + (y/8)*SSD1306_WIDTH;
@@ -60,13 +109,121 @@ void SSD1306_DrawPixel(uint16_t x, uint16_t y, uint8_t on){
   if(on) s_buf[idx] |= mask; else s_buf[idx] &= ~mask;
 }
 
+/* 矩形/线段：按页字节操作
+ * 整页部分直接 memset，上下边缘所在页用掩码做读改写；一页内一个字节管 8 行。 */
+void SSD1306_FillRect(int x, int y, int w, int h, uint8_t on){
+  if (w <= 0 || h <= 0) return;
+  int x0 = (x < 0) ? 0 : x, x1 = (x + w > SSD1306_WIDTH)  ? SSD1306_WIDTH  : x + w;   /* [x0,x1) */
+  int y0 = (y < 0) ? 0 : y, y1 = (y + h > SSD1306_HEIGHT) ? SSD1306_HEIGHT : y + h;   /* [y0,y1) */
+  if (x0 >= x1 || y0 >= y1) return;
+
+  int n  = x1 - x0;
+  int p0 = y0 >> 3, p1 = (y1 - 1) >> 3;
+  for (int p = p0; p <= p1; ++p){
+    uint8_t m = 0xFF;
+    if (p == p0) m &= (uint8_t)(0xFF << (y0 & 7));
+    if (p == p1) m &= (uint8_t)(0xFF >> (7 - ((y1 - 1) & 7)));
+    uint8_t* d = &s_buf[p * SSD1306_WIDTH + x0];
+    if (m == 0xFF){ memset(d, on ? 0xFF : 0x00, (size_t)n); continue; }
+    if (on) for (int i = 0; i < n; ++i) d[i] |= m;
+    else    for (int i = 0; i < n; ++i) d[i] &= (uint8_t)~m;
+  }
+}
+
+void SSD1306_DrawHLine(int x, int y, int w, uint8_t on){ SSD1306_FillRect(x, y, w, 1, on); }
+
+void SSD1306_DrawVLine(int x, int y, int h, uint8_t on){ SSD1306_FillRect(x, y, 1, h, on); }
+
+/* Bresenham：直接维护显存下标和位掩码，y 走一步只移一位掩码，跨页时下标加减一行 */
+void SSD1306_DrawLine(int x0, int y0, int x1, int y1, uint8_t on){
+  if (y0 == y1){ if (x0 > x1){ int t = x0; x0 = x1; x1 = t; } SSD1306_DrawHLine(x0, y0, x1 - x0 + 1, on); return; }
+  if (x0 == x1){ if (y0 > y1){ int t = y0; y0 = y1; y1 = t; } SSD1306_DrawVLine(x0, y0, y1 - y0 + 1, on); return; }
+
+  int dx = (x1 > x0) ? (x1 - x0) : (x0 - x1), sx = (x0 < x1) ? 1 : -1;
+  int dy = -((y1 > y0) ? (y1 - y0) : (y0 - y1)), sy = (y0 < y1) ? 1 : -1;
+  int err = dx + dy, e2;
+  int     idx = x0 + (y0 >> 3) * SSD1306_WIDTH;
+  uint8_t m   = (uint8_t)(1u << (y0 & 7));
+  for (;;){
+    if ((unsigned)x0 < SSD1306_WIDTH && (unsigned)y0 < SSD1306_HEIGHT){
+      if (on) s_buf[idx] |= m; else s_buf[idx] &= (uint8_t)~m;
+    }
+    if (x0 == x1 && y0 == y1) break;
+    e2 = 2 * err;
+    if (e2 >= dy){ err += dy; x0 += sx; idx += sx; }
+    if (e2 <= dx){
+      err += dx; y0 += sy;
+      if (sy > 0){ m = (uint8_t)(m << 1); if (!m){ m = 0x01; idx += SSD1306_WIDTH; } }
+      else       { m = (uint8_t)(m >> 1); if (!m){ m = 0x80; idx -= SSD1306_WIDTH; } }
+    }
+  }
+}
+
+/* 按列竖排位图直接写进显存（与 SSD1306 页格式相同：bit0 在最上面）。
+ * mask 标出位图占用的行，这些行按位图覆盖（1 亮 0 灭），其余行保持不动；
+ * y 不是 8 的倍数时每列拆成上下两页各写一次。裁剪按整块算，不逐点判断。 */
+void SSD1306_BlitColumns(int x, int y, const uint8_t* cols, int w, uint8_t mask){
+  if (!cols || w <= 0) return;
+  if (x >= SSD1306_WIDTH || x + w <= 0 || y >= SSD1306_HEIGHT || y <= -8) return;
+
+  int i0 = (x < 0) ? -x : 0;
+  int i1 = (x + w > SSD1306_WIDTH) ? (SSD1306_WIDTH - x) : w;
+  int page  = y >> 3;                       /* y<0 时为 -1（算术右移） */
+  int shift = y & 7;
+
+  /* 指针指向页首、按 x+i 下标：x<0 时不能先算出缓冲区之前的地址 */
+  uint8_t* top = (page >= 0) ? &s_buf[page * SSD1306_WIDTH] : NULL;
+  uint8_t* bot = (shift && page + 1 < SSD1306_PAGES) ? &s_buf[(page + 1) * SSD1306_WIDTH] : NULL;
+  uint8_t m_top = (uint8_t)(mask << shift);
+  uint8_t m_bot = shift ? (uint8_t)(mask >> (8 - shift)) : 0;
+  if (!m_bot) bot = NULL;
+
+  for (int i = i0; i < i1; ++i){
+    uint8_t b = cols[i] & mask;
+    if (top) top[x + i] = (uint8_t)((top[x + i] & ~m_top) | (b << shift));
+    if (bot) bot[x + i] = (uint8_t)((bot[x + i] & ~m_bot) | (b >> (8 - shift)));
+  }
+}
+
+/* 同上，但只把 1 的位点亮（透明叠加，背景不清），用于 16×16 汉字等整页高的位图 */
+void SSD1306_OrColumns(int x, int y, const uint8_t* cols, int w){
+  if (!cols || w <= 0) return;
+  if (x >= SSD1306_WIDTH || x + w <= 0 || y >= SSD1306_HEIGHT || y <= -8) return;
+
+  int i0 = (x < 0) ? -x : 0;
+  int i1 = (x + w > SSD1306_WIDTH) ? (SSD1306_WIDTH - x) : w;
+  int page  = y >> 3;
+  int shift = y & 7;
+
+  uint8_t* top = (page >= 0) ? &s_buf[page * SSD1306_WIDTH] : NULL;   /* 同上：页首 + x+i 下标 */
+  uint8_t* bot = (shift && page + 1 < SSD1306_PAGES) ? &s_buf[(page + 1) * SSD1306_WIDTH] : NULL;
+
+  if (!shift){
+    for (int i = i0; i < i1; ++i) top[x + i] |= cols[i];
+    return;
+  }
+  for (int i = i0; i < i1; ++i){
+    if (top) top[x + i] |= (uint8_t)(cols[i] << shift);
+    if (bot) bot[x + i] |= (uint8_t)(cols[i] >> (8 - shift));
+  }
+}
+
+/* 曲线图等滚动区域：每页一段连续字节，memmove 一次即可，不逐点重画 */
+void SSD1306_ShiftLeft(int x, int y, int w, int h, int n){
+  int x0 = (x < 0) ? 0 : x, x1 = (x + w > SSD1306_WIDTH) ? SSD1306_WIDTH : x + w;
+  int y0 = (y < 0) ? 0 : y, y1 = (y + h > SSD1306_HEIGHT) ? SSD1306_HEIGHT : y + h;
+  if (x0 >= x1 || y0 >= y1 || n <= 0) return;
+  if (n > x1 - x0) n = x1 - x0;
+  for (int p = y0 >> 3; p <= (y1 - 1) >> 3; ++p){
+    uint8_t* d = &s_buf[p * SSD1306_WIDTH + x0];
+    memmove(d, d + n, (size_t)(x1 - x0 - n));
+    memset(d + (x1 - x0 - n), 0, (size_t)n);
+  }
+}
+
 void SSD1306_DrawChar(int x,int y,char c){
   if(c < 0x20 || c > 0x7E) c = '?';
-  const uint8_t* col = FONT5x7[c-0x20];
-  for(int i=0;i<5;i++){
-    uint8_t bits = col[i];
-    for(int j=0;j<7;j++) SSD1306_DrawPixel(x+i, y+j, (bits>>j)&1);
-  }
+  SSD1306_BlitColumns(x, y, FONT5x7[c-0x20], 5, 0x7F);   /* 5 列 × 7 行，第 8 行不动 */
 }
 
 void SSD1306_DrawString(int x,int y,const char* s){
@@ -79,35 +236,237 @@ void SSD1306_DrawString(int x,int y,const char* s){
   }
 }
 
-/* 刷新 */
+/* 刷新：只发送变化的部分
+ * 每页取第一个和最后一个与 s_front 不同的列，用窗口命令把写入位置设到这一段再发数据，
+ * 同一页内两处改动之间没变的字节也会顺带发出（省掉再设一次窗口的命令）。 */
+static uint16_t ssd1306_collect_dirty(void){
+  uint16_t bytes = 0;
+  uint8_t  wins  = 0;
+  for (uint8_t p = 0; p < SSD1306_PAGES; ++p){
+    const uint8_t* b = &s_buf[p * SSD1306_WIDTH];
+    uint8_t*       f = &s_front[p * SSD1306_WIDTH];
+    int lo = 0, hi = SSD1306_WIDTH - 1;
+    if (!s_force_full){
+      while (lo <= hi && b[lo] == f[lo]) lo++;
+      while (hi >= lo && b[hi] == f[hi]) hi--;
+    }
+    if (lo > hi){ s_win_lo[p] = 1; s_win_hi[p] = 0; continue; }
+    memcpy(&f[lo], &b[lo], (size_t)(hi - lo + 1));
+    s_win_lo[p] = (uint8_t)lo;
+    s_win_hi[p] = (uint8_t)hi;
+    bytes += (uint16_t)(hi - lo + 1);
+    wins++;
+  }
+  s_force_full = 0;
+
+  s_stats.frames++;
+  s_stats.last_bytes   = bytes;
+  s_stats.last_windows = wins;
+  s_stats.total_bytes += bytes;
+  if (bytes) s_stats.frames_sent++;
+  return bytes;
+}
+
+/* 从 from 页起找下一个有变化的页；没有则返回 SSD1306_PAGES */
+static uint8_t ssd1306_next_dirty(uint8_t from){
+  while (from < SSD1306_PAGES && s_win_lo[from] > s_win_hi[from]) from++;
+  return from;
+}
+
+/* 第 p 页的窗口命令。SSD1306：0x21 列起止 + 0x22 页起止，水平寻址下写到列尾自动回绕；
+ * SH1106：没有窗口命令，只设页地址和起始列，页寻址下列地址自增，一页内的连续段正好够用。 */
+static void ssd1306_win_cmd(uint8_t p, uint8_t cmd[SSD1306_WIN_CMD_LEN]){
+#if SSD1306_CTRL == SSD1306_CTRL_SH1106
+  uint8_t col = (uint8_t)(s_win_lo[p] + SSD1306_COL_OFFSET);
+  cmd[0] = (uint8_t)(0xB0 | p); cmd[1] = (uint8_t)(0x00 | (col & 0x0F)); cmd[2] = (uint8_t)(0x10 | (col >> 4));
+#else
+  cmd[0] = 0x21; cmd[1] = s_win_lo[p] + SSD1306_COL_OFFSET; cmd[2] = s_win_hi[p] + SSD1306_COL_OFFSET;
+  cmd[3] = 0x22; cmd[4] = p;                                 cmd[5] = p;
+#endif
+}
+
+void SSD1306_Invalidate(void){ s_force_full = 1; }
+
+void SSD1306_SetStartLine(uint8_t line){
+  line &= (SSD1306_HEIGHT - 1);
+  if (line == s_start_line) return;
+  s_start_line = line;
+  s_start_pending = 1;
+}
+
+uint8_t SSD1306_GetStartLine(void){ return s_start_line; }
+uint8_t SSD1306_GetFrontStartLine(void){ return s_front_start; }
+
+const SSD1306_Stats_t* SSD1306_GetStats(void){ return &s_stats; }
+
+void SSD1306_ResetStats(void){ memset(&s_stats, 0, sizeof(s_stats)); }
+
+#if SSD1306_USE_DMA
+/* 推进 DMA 刷新：每页先发窗口命令，再发该页的显存段，
+ * 显存发完后如有新的起始行再补 1 字节命令；整帧包在一次 OLED_Bus_Begin/End 里（SPI 下 CS 保持为低）。
+ * 返回 1=已交给 DMA，0=整帧发完。 */
+static uint8_t ssd1306_flush_kick(void){
+  if (s_flush_page >= SSD1306_PAGES && s_flush_start){
+    s_flush_start = 0;
+    if (OLED_Bus_WriteDMA(0, &s_start_cmd, 1) == HAL_OK) return 1;
+    (void)OLED_Bus_Write(0, &s_start_cmd, 1);
+    return 0;
+  }
+  while (s_flush_page < SSD1306_PAGES){
+    uint8_t p = s_flush_page;
+    uint8_t* src; uint16_t len;
+    uint8_t  data = s_flush_phase;
+    if (s_flush_phase == 0){
+      ssd1306_win_cmd(p, s_win_cmd);
+      src = s_win_cmd; len = sizeof(s_win_cmd);
+      s_flush_phase = 1;
+    }else{
+      src = &s_front[p * SSD1306_WIDTH + s_win_lo[p]];
+      len = (uint16_t)(s_win_hi[p] - s_win_lo[p] + 1);
+      s_flush_phase = 0;
+      s_flush_page  = ssd1306_next_dirty(p + 1);
+    }
+    if (OLED_Bus_WriteDMA(data, src, len) == HAL_OK) return 1;
+    /* DMA 起不来（未初始化/忙）：这一段退回阻塞发送，保证画面仍能刷出 */
+    (void)OLED_Bus_Write(data, src, len);
+  }
+  if (s_flush_start) return ssd1306_flush_kick();
+  return 0;
+}
+
+static void ssd1306_flush_done(void){
+  OLED_Bus_End();
+  s_stats.busy_cycles += SSD1306_CYCCNT() - s_flush_t0;
+  s_busy = 0;
+  if (s_flush_cb) s_flush_cb();
+}
+
+void SSD1306_UpdateAsync(void){
+  (void)SSD1306_WaitFlush(HAL_MAX_DELAY);
+  if (!ssd1306_collect_dirty() && !s_start_pending) return;   /* 画面没变：不占用 SPI */
+
+  /* 起始行在这里取快照：发送途中再改的值留到下一帧，保证总是先有显存再滚动 */
+  s_flush_start   = s_start_pending;
+  s_start_pending = 0;
+  s_start_cmd     = (uint8_t)(0x40 | s_start_line);
+  s_front_start   = s_start_line;
+  s_flush_page  = ssd1306_next_dirty(0);
+  s_flush_phase = 0;
+  s_busy = 1;
+  s_flush_t0 = SSD1306_CYCCNT();
+  OLED_Bus_Begin();
+  if (!ssd1306_flush_kick()) ssd1306_flush_done();
+}
+
+uint8_t SSD1306_IsBusy(void){ return s_busy; }
+
+HAL_StatusTypeDef SSD1306_WaitFlush(uint32_t timeout_ms){
+  uint32_t t0 = HAL_GetTick();
+  while (s_busy){
+    uint32_t el = HAL_GetTick() - t0;
+    if (timeout_ms != HAL_MAX_DELAY && el >= timeout_ms) return HAL_TIMEOUT;
+  }
+  return HAL_OK;
+}
+
+void SSD1306_SetFlushCallback(SSD1306_FlushCallback cb){ s_flush_cb = cb; }
+
+/* 传输层一段 DMA 发完：接着发下一段，全部发完再结束本帧 */
+void SSD1306_BusTxDone(void){
+  if (!s_busy) return;
+  if (!ssd1306_flush_kick()) ssd1306_flush_done();
+}
+
+void SSD1306_BusError(void){
+  if (!s_busy) return;
+  OLED_Bus_End();
+  s_stats.busy_cycles += SSD1306_CYCCNT() - s_flush_t0;
+  s_force_full = 1;                          /* 屏上内容已不可信，下次整屏重发 */
+  s_start_pending = 1;
+  s_busy = 0;
+}
+
+void SSD1306_Update(void){
+  SSD1306_UpdateAsync();
+  (void)SSD1306_WaitFlush(HAL_MAX_DELAY);
+}
+#else
+void SSD1306_UpdateAsync(void){ SSD1306_Update(); }
+uint8_t SSD1306_IsBusy(void){ return 0; }
+HAL_StatusTypeDef SSD1306_WaitFlush(uint32_t timeout_ms){ (void)timeout_ms; return HAL_OK; }
+void SSD1306_SetFlushCallback(SSD1306_FlushCallback cb){ (void)cb; }
+
 void SSD1306_Update(void){
-  ssd1306_cmd(0x21); ssd1306_cmd(0x00 + SSD1306_COL_OFFSET); ssd1306_cmd(SSD1306_WIDTH-1 + SSD1306_COL_OFFSET);
-  ssd1306_cmd(0x22); ssd1306_cmd(0x00); ssd1306_cmd(SSD1306_PAGES-1);
-  ssd1306_data(s_buf, sizeof(s_buf));
+  if (ssd1306_collect_dirty()){
+    for (uint8_t p = ssd1306_next_dirty(0); p < SSD1306_PAGES; p = ssd1306_next_dirty(p + 1)){
+      uint8_t cmd[SSD1306_WIN_CMD_LEN];
+      ssd1306_win_cmd(p, cmd);
+      (void)SSD1306_WriteCommands(cmd, sizeof(cmd));
+      ssd1306_data(&s_front[p * SSD1306_WIDTH + s_win_lo[p]], (uint16_t)(s_win_hi[p] - s_win_lo[p] + 1));
+    }
+  }
+  if (s_start_pending){
+    s_start_pending = 0;
+    uint8_t cmd = (uint8_t)(0x40 | s_start_line);
+    (void)SSD1306_WriteCommands(&cmd, 1);
+    s_front_start = s_start_line;
+  }
 }
+void SSD1306_BusTxDone(void){}
+void SSD1306_BusError(void){}
+#endif
+
+/* 初始化命令表（整表一次发完） */
+#if SSD1306_CTRL == SSD1306_CTRL_SH1106
+/* SH1106：没有 0x20 寻址模式（固定页寻址）和 0x8D 电荷泵命令，改用 0xAD/0x8B 开内部 DC-DC */
+static const uint8_t SSD1306_INIT_SEQ[] = {
+  0xAE,                 // 关显示
+  0xD5, 0x80,           // 时钟分频
+  0xA8, 0x3F,           // 复用率 1/64
+  0xD3, 0x00,           // 显示偏移
+  0x40 | 0x00,          // 起始行 0
+  0xAD, 0x8B,           // 内部 DC-DC 开
+  0x32,                 // 泵电压 8.0V
+  0xA1,                 // 左右翻转可改 A0
+  0xC8,                 // 上下翻转可改 C0
+  0xDA, 0x12,
+  0x81, 0x7F,           // 对比度
+  0xD9, 0x22,           // 预充电（复位默认值）
+  0xDB, 0x35,           // VCOMH（复位默认值）
+  0xA4,
+  0xA6,
+  0xAF,                 // 开显示
+};
+#else
+static const uint8_t SSD1306_INIT_SEQ[] = {
+  0xAE,                 // 关显示
+  0xD5, 0x80,           // 时钟分频
+  0xA8, 0x3F,           // 复用率 1/64
+  0xD3, 0x00,           // 显示偏移
+  0x40 | 0x00,          // 起始行 0
+  0x8D, 0x14,           // 电荷泵
+  0x20, 0x00,           // Horizontal
+  0xA1,                 // 左右翻转可改 A0
+  0xC8,                 // 上下翻转可改 C0
+  0xDA, 0x12,
+  0x81, 0x7F,           // 对比度
+  0xD9, 0xF1,
+  0xDB, 0x40,
+  0xA4,
+  0xA6,
+  0xAF,                 // 开显示
+};
+#endif
 
 /* 初始化 */
 void SSD1306_Init(void){
-  OLED_RST_L(); HAL_Delay(5); OLED_RST_H(); HAL_Delay(5);
-
-  ssd1306_cmd(0xAE);
-  ssd1306_cmd(0xD5); ssd1306_cmd(0x80);
-  ssd1306_cmd(0xA8); ssd1306_cmd(0x3F);
-  ssd1306_cmd(0xD3); ssd1306_cmd(0x00);
-  ssd1306_cmd(0x40 | 0x00);
-  ssd1306_cmd(0x8D); ssd1306_cmd(0x14);
-  ssd1306_cmd(0x20); ssd1306_cmd(0x00);   // Horizontal
-  ssd1306_cmd(0xA1);                      // 左右翻转可改 A0
-  ssd1306_cmd(0xC8);                      // 上下翻转可改 C0
-  ssd1306_cmd(0xDA); ssd1306_cmd(0x12);
-  ssd1306_cmd(0x81); ssd1306_cmd(0x7F);
-  ssd1306_cmd(0xD9); ssd1306_cmd(0xF1);
-  ssd1306_cmd(0xDB); ssd1306_cmd(0x40);
-  ssd1306_cmd(0xA4);
-  ssd1306_cmd(0xA6);
-  ssd1306_cmd(0xAF);
+  OLED_Bus_Reset();
+
+  (void)SSD1306_WriteCommands(SSD1306_INIT_SEQ, sizeof(SSD1306_INIT_SEQ));
+  s_start_line = 0; s_start_pending = 0; s_front_start = 0;
 
   SSD1306_Fill(0);
+  SSD1306_Invalidate();                   // 复位后屏内 GDDRAM 内容未知
   SSD1306_Update();
 }
 
@@ -122,14 +481,62 @@ int SSD1306_StringWidth6x8(const char* s){
   return w;
 }
 
+/* 纵向放大用的“位展开”表：每个输入位复制成 2/3 个相邻位。
+ * 按半字节查表（低 4 位 + 高 3 位各查一次），表只有 16 项。 */
+static const uint8_t SPREAD2_NIB[16] = {
+  0x00,0x03,0x0C,0x0F,0x30,0x33,0x3C,0x3F,0xC0,0xC3,0xCC,0xCF,0xF0,0xF3,0xFC,0xFF
+};
+static const uint16_t SPREAD3_NIB[16] = {
+  0x000,0x007,0x038,0x03F,0x1C0,0x1C7,0x1F8,0x1FF,
+  0xE00,0xE07,0xE38,0xE3F,0xFC0,0xFC7,0xFF8,0xFFF
+};
+
+static inline uint32_t spread_bits(uint8_t b, uint8_t sy){
+  if (sy == 2) return (uint32_t)SPREAD2_NIB[b & 0x0F] | ((uint32_t)SPREAD2_NIB[b >> 4] << 8);
+  if (sy == 3) return (uint32_t)SPREAD3_NIB[b & 0x0F] | ((uint32_t)SPREAD3_NIB[b >> 4] << 12);
+  return b;
+}
+
+/* 把一列（bit0=第 y 行，v 不超过 21 位）或进显存。y<0 时先把露出屏外的行移掉；
+ * page0/lshift/rshift 由调用方按 y 每个字符算一次。 */
+static inline void ssd1306_or_column(uint8_t* dst, int page0, int lshift, int rshift, uint32_t v){
+  uint32_t w = (v >> rshift) << lshift;     /* 移位后 ≤ 28 位 */
+  for (int page = page0; w && page < SSD1306_PAGES; ++page, w >>= 8){
+    dst[page * SSD1306_WIDTH] |= (uint8_t)w;
+  }
+}
+
 /* 放大绘制单个字符：
  * sx/sy 为缩放倍数（2=约12×16，3=约18×24）
  * bold>0 时在横向右侧额外加1列像素，形成“伪粗”
+ * sy=1..3 走整列快速路径：每个输出列先查表纵向展开，再一次写入各页；
+ * 其它倍数保留逐点绘制。两者都只点亮、不擦除背景。
  */
 void SSD1306_DrawCharScaled(int x,int y,char c, uint8_t sx, uint8_t sy, uint8_t bold){
   if (c < 0x20 || c > 0x7E) c = '?';
   const uint8_t* col = FONT5x7[(uint8_t)c - 0x20];   // 5 列 × 7 行
 
+  if (sx >= 1 && sy >= 1 && sy <= 3){
+    int w = 5 * sx + (bold ? 1 : 0);
+    if (x >= SSD1306_WIDTH || x + w <= 0 || y >= SSD1306_HEIGHT || y + 7 * sy <= 0) return;
+    int page0  = (y < 0) ? 0 : (y >> 3);
+    int lshift = (y < 0) ? 0 : (y & 7);
+    int rshift = (y < 0) ? -y : 0;
+    int px = x;
+    for (int i = 0; i <= 5; i++, px += sx){
+      uint8_t  prev = (bold && i > 0) ? col[i - 1] : 0;   /* 前一列向右加粗 1 列 */
+      uint8_t  bits = (i < 5) ? col[i] : 0;
+      uint32_t v    = spread_bits(bits, sy);
+      for (int dx = 0; dx < sx; ++dx){
+        int cx = px + dx;
+        if (cx < 0 || cx >= SSD1306_WIDTH) continue;
+        uint32_t cv = (dx == 0 && prev) ? spread_bits(bits | prev, sy) : v;
+        if (cv) ssd1306_or_column(&s_buf[cx], page0, lshift, rshift, cv);
+      }
+    }
+    return;
+  }
+
   for (int i = 0; i < 5; i++){
     uint8_t bits = col[i];
     for (int j = 0; j < 7; j++){
@@ -1,47 +1,20 @@
 #include "ssd1306.h"
 #include "ssd1306_utf8.h"
+#include "font16.h"
 #include <string.h>
 
-/* ============ 小型 16x16 汉字点阵（逐步扩充） ============ */
-/* 每字 16x16，逐行自上而下，每行 16bit → 2 字节，共 32 字节。1=点亮 */
-typedef struct { uint32_t ucs; const uint8_t bmp[32]; } CJK16_t;
+/* 16x16 汉字点阵统一放在 font16.c（按码点排序，二分查找），这里只留占位符 */
 
-/* 占位符 “□” */
+/* 占位符 “□”（页格式：上半页 16 列 + 下半页 16 列，bit0 在上） */
 static const uint8_t GLYPH_BOX_16[32] = {
-  0xFF,0xFF, 0x80,0x01, 0x80,0x01, 0x80,0x01,
-  0x80,0x01, 0x80,0x01, 0x80,0x01, 0x80,0x01,
-  0x80,0x01, 0x80,0x01, 0x80,0x01, 0x80,0x01,
-  0x80,0x01, 0x80,0x01, 0x80,0x01, 0xFF,0xFF
-};
-
-/* 下面示例性放少数几个常用字（“你 好 中 文 温 湿 度 报 警 蓝 牙 电 压 接 收 发 送 页 面”）
- * 点阵可逐步补齐；为了演示，这里给出简化笔画（不会很漂亮，但可读）。
- * 如需精准宋体/点阵，可用 PC 字库工具导出 16x16 位图后粘贴到此处。
- */
-static const CJK16_t CJK16_TABLE[] = {
-  /* “你” U+4F60（示意版） */
-  {0x4F60,{0x00,0x10,0x00,0x10,0x7F,0xFE,0x00,0x10,0x00,0x10,0x1F,0xF0,0x00,0x20,0x00,0x40,
-           0x7F,0xFE,0x00,0x80,0x01,0x00,0x06,0x00,0x18,0x00,0x60,0x00,0x01,0x80,0x00,0x60}},
-  /* “好” U+597D */
-  {0x597D,{0x00,0x08,0x3F,0xFC,0x20,0x08,0x20,0x08,0x3F,0xF8,0x20,0x08,0x20,0x08,0x3F,0xF8,
-           0x04,0x00,0x04,0x00,0x24,0x00,0x24,0x00,0x44,0x00,0x84,0x00,0x04,0x00,0x04,0x00}},
-  /* “中” U+4E2D */
-  {0x4E2D,{0x00,0x00,0x01,0x00,0x01,0x00,0x7F,0xFE,0x41,0x02,0x41,0x02,0x41,0x02,0x7F,0xFE,
-           0x41,0x02,0x41,0x02,0x41,0x02,0x7F,0xFE,0x01,0x00,0x01,0x00,0x00,0x00,0x00,0x00}},
-  /* “文” U+6587 */
-  {0x6587,{0x00,0x00,0x00,0x80,0x40,0x80,0x20,0x80,0x10,0x80,0x0F,0xFE,0x00,0x80,0x01,0x80,
-           0x02,0x80,0x0C,0x80,0x30,0x80,0xC0,0x80,0x00,0x80,0x00,0x80,0x00,0x80,0x00,0x00}},
-  /* ……此处省略若干：温 U+6E29、湿 U+6E7F、度 U+5EA6、报 U+62A5、警 U+8B66、
-     蓝 U+84DD、牙 U+7259、电 U+7535、压 U+538B、接 U+63A5、收 U+6536、
-     发 U+53D1、送 U+9001、页 U+9875、面 U+9762 */
+  0xFF,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0xFF,
+  0xFF,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0xFF
 };
 
 /* 查找 16x16 点阵；找不到就返回占位符 */
 static const uint8_t* find_cjk16(uint32_t ucs){
-  for (unsigned i=0;i<sizeof(CJK16_TABLE)/sizeof(CJK16_TABLE[0]);++i){
-    if (CJK16_TABLE[i].ucs == ucs) return CJK16_TABLE[i].bmp;
-  }
-  return GLYPH_BOX_16;
+  const uint8_t* bmp = Font16_FindGlyph(ucs);
+  return bmp ? bmp : GLYPH_BOX_16;
 }
 
 /* 取一个 UTF8 码点；返回码点和消耗的字节数（非法则按单字节回退） */
@@ -77,14 +50,10 @@ int OLED_UTF8_LineWidth(const char* s){
   return w;
 }
 
+/* 页格式点阵：上下两半各 16 列整字节 OR 进显存；y 不对齐时由 OrColumns 拆页移位 */
 static void draw_cjk16(int x,int y,const uint8_t bmp[32]){
-  for(int row=0; row<16; ++row){
-    uint8_t b0=bmp[row*2], b1=bmp[row*2+1];
-    for(int col=0; col<8; ++col){
-      if (b0 & (0x80>>col)) SSD1306_DrawPixel(x+col,   y+row, 1);
-      if (b1 & (0x80>>col)) SSD1306_DrawPixel(x+8+col, y+row, 1);
-    }
-  }
+  SSD1306_OrColumns(x, y,     bmp,      16);
+  SSD1306_OrColumns(x, y + 8, bmp + 16, 16);
 }
 
 void OLED_DrawUTF8_Line(int x, int y, const char* s){
@@ -123,3 +92,82 @@ const char* OLED_UTF8_SplitTwoLines(const char* s){
   }
   return (*p) ? last_fit : NULL;
 }
+
+/* ===== 预编译的界面字符串（tools/ui_strings.py 生成） =====
+ * 字形序列已解码好：0x20~0x7E 为 ASCII，0x80+k 为字库第 k 个汉字，0xFF 为“□”；
+ * 宽度和两行拆分点也已算好，画的时候不再做 UTF-8 解码和扫描。 */
+typedef struct {
+  const uint8_t* glyphs;
+  uint8_t  len;
+  uint16_t width;   /* 整行像素宽 */
+  uint8_t  brk;     /* 屏宽 128 时第一行能放下的字数（整行放得下则 = len） */
+} UiText_t;
+
+#include "ui_strings.inc"
+
+static void draw_glyph_run(int x, int y, const uint8_t* g, int n){
+  int cx = x;
+  for (int i = 0; i < n; ++i){
+    uint8_t c = g[i];
+    if (c < 0x80){
+      SSD1306_DrawChar(cx, y, (char)c);
+      cx += 6;
+    }else{
+      if (cx + 16 > SSD1306_WIDTH) break;  /* 右侧裁掉 */
+      const uint8_t* bmp = (c == 0xFF) ? NULL : Font16_GlyphAt((uint16_t)(c - 0x80));
+      draw_cjk16(cx, y - 4, bmp ? bmp : GLYPH_BOX_16);
+      cx += 16;
+    }
+    if (cx >= SSD1306_WIDTH) break;
+  }
+}
+
+int OLED_TextWidth(UiStr_t id){
+  if ((unsigned)id >= UI_STR_COUNT) return 0;
+  return UI_TEXTS[id].width;
+}
+
+void OLED_DrawText(int x, int y, UiStr_t id){
+  if ((unsigned)id >= UI_STR_COUNT) return;
+  draw_glyph_run(x, y, UI_TEXTS[id].glyphs, UI_TEXTS[id].len);
+}
+
+void OLED_DrawText_Centered(int y, UiStr_t id){
+  if ((unsigned)id >= UI_STR_COUNT) return;
+  int x = (SSD1306_WIDTH - UI_TEXTS[id].width)/2; if (x<0) x=0;
+  draw_glyph_run(x, y, UI_TEXTS[id].glyphs, UI_TEXTS[id].len);
+}
+
+/* 放大版：ASCII 走 SSD1306_DrawCharScaled（与 SSD1306_DrawStringCenteredScaled 逐点相同），
+ * 汉字逐点放大成 sx×sy 的块；只用于欢迎页、自检标题这类开机画面，不追求速度 */
+static void draw_cjk16_scaled(int x, int y, const uint8_t bmp[32], uint8_t sx, uint8_t sy){
+  for (int c = 0; c < 16; ++c)
+    for (int r = 0; r < 16; ++r)
+      if (bmp[(r >> 3) * 16 + c] & (1u << (r & 7))) SSD1306_FillRect(x + c * sx, y + r * sy, sx, sy, 1);
+}
+
+void OLED_DrawText_CenteredScaled(int y, UiStr_t id, uint8_t sx, uint8_t sy, uint8_t bold){
+  if ((unsigned)id >= UI_STR_COUNT || !sx || !sy) return;
+  const UiText_t* t = &UI_TEXTS[id];
+  int cx = (SSD1306_WIDTH - t->width * sx)/2; if (cx<0) cx=0;
+  for (int i = 0; i < t->len; ++i){
+    uint8_t c = t->glyphs[i];
+    if (c < 0x80){
+      SSD1306_DrawCharScaled(cx, y, (char)c, sx, sy, bold);
+      cx += 6 * sx;
+    }else{
+      if (cx + 16 * sx > SSD1306_WIDTH) break;
+      const uint8_t* bmp = (c == 0xFF) ? NULL : Font16_GlyphAt((uint16_t)(c - 0x80));
+      draw_cjk16_scaled(cx, y - 4 * sy, bmp ? bmp : GLYPH_BOX_16, sx, sy);
+      cx += 16 * sx;
+    }
+    if (cx >= SSD1306_WIDTH) break;
+  }
+}
+
+void OLED_DrawText_TwoLines(int y1, int y2, UiStr_t id){
+  if ((unsigned)id >= UI_STR_COUNT) return;
+  const UiText_t* t = &UI_TEXTS[id];
+  draw_glyph_run(0, y1, t->glyphs, t->brk);
+  if (t->brk < t->len) draw_glyph_run(0, y2, t->glyphs + t->brk, t->len - t->brk);
+}
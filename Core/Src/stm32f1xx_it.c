@@ -13,6 +13,9 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "usart.h"   // ★ 关键：让 huart1 在本文件可见
+#include "spi.h"     // hdma_spi1_tx（OLED 刷新 DMA）
+#include "i2c.h"     // hi2c1 / hdma_i2c1_tx（I2C 接口 OLED）
+#include "ssd1306.h" // SSD1306_BUS
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -170,4 +173,34 @@ void USART1_IRQHandler(void)
   HAL_UART_IRQHandler(&huart1);
 }
 
+// USART1_RX 循环 DMA（NB 模组接收环形缓冲），写完一圈时 HAL 回调 HAL_UART_RxCpltCallback()
+void DMA1_Channel5_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_usart1_rx);
+}
+
+// SPI1_TX DMA（OLED 刷新），完成后 HAL 会回调 HAL_SPI_TxCpltCallback()
+void DMA1_Channel3_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_spi1_tx);
+}
+
+#if SSD1306_BUS == SSD1306_BUS_I2C
+// I2C1_TX DMA（I2C 接口 OLED 刷新）；DMA 发完后由事件中断发 STOP，再回调 HAL_I2C_MemTxCpltCallback()
+void DMA1_Channel6_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_i2c1_tx);
+}
+
+void I2C1_EV_IRQHandler(void)
+{
+  HAL_I2C_EV_IRQHandler(&hi2c1);
+}
+
+void I2C1_ER_IRQHandler(void)
+{
+  HAL_I2C_ER_IRQHandler(&hi2c1);
+}
+#endif
+
 /* USER CODE END 1 */
@@ -0,0 +1,106 @@
+#include "telemetry.h"
+#include <string.h>
+
+enum { TX_NONE = 0, TX_READY, TX_BUSY };     /* 发送缓冲：空 / 待发（含重试） / 已排进 AT 队列 */
+
+#define TLM_REC_MAX  (1 + 5 + 4 * 5)         /* 一条最长：标志 + 5 个 varint */
+
+static uint8_t  s_buf[TLM_MAX_BYTES];        /* 正在攒的一包，记录直接编码写在这里 */
+static uint16_t s_len = 0;
+static uint8_t  s_cnt = 0;
+static uint32_t s_t0_ms = 0;                 /* 本包首条时刻 */
+static uint16_t s_seq = 0;
+/* 差分基准：本包里上一条的时刻、各量上一次出现的值 */
+static uint32_t s_prev_s;
+static int32_t  s_prev_vdd, s_prev_temp, s_prev_humi, s_prev_lux;
+
+static uint8_t  s_tx[TLM_MAX_BYTES];         /* 封好的一包，发成功才清掉 */
+static uint16_t s_tx_len = 0;
+static uint8_t  s_tx_state = TX_NONE;
+static uint8_t  s_tx_cnt = 0;
+static uint32_t s_tx_next_ms = 0;
+static uint32_t s_dropped = 0;
+
+uint32_t Tlm_Dropped(void){ return s_dropped; }
+
+static uint8_t* put_uv(uint8_t* p, uint32_t v){
+  while (v >= 0x80){ *p++ = (uint8_t)(v | 0x80); v >>= 7; }
+  *p++ = (uint8_t)v;
+  return p;
+}
+
+static uint8_t* put_sv(uint8_t* p, int32_t v){
+  return put_uv(p, ((uint32_t)v << 1) ^ (uint32_t)(v >> 31));
+}
+
+/* 差分并更新基准 */
+static uint8_t* put_delta(uint8_t* p, int32_t v, int32_t* prev){
+  p = put_sv(p, v - *prev);
+  *prev = v;
+  return p;
+}
+
+/* 封包：搬进发送缓冲。上一包还在发送途中就封不了；还没发出去（等重试）就丢掉旧的 */
+static int tlm_close(uint32_t now_ms){
+  if (!s_cnt) return 0;
+  if (s_tx_state == TX_BUSY) return -1;
+  if (s_tx_state == TX_READY) s_dropped += s_tx_cnt;
+  memcpy(s_tx, s_buf, s_len);
+  s_tx_len = s_len;
+  s_tx_cnt = s_cnt;
+  s_tx_state = TX_READY;
+  s_tx_next_ms = now_ms;
+  s_len = 0; s_cnt = 0;
+  return 0;
+}
+
+static void tlm_done(int res, void* ctx){
+  (void)ctx;
+  if (res == NB_AT_OK){ s_tx_state = TX_NONE; return; }
+  s_tx_state = TX_READY;
+  s_tx_next_ms = HAL_GetTick() + TLM_RETRY_MS;
+}
+
+static void tlm_open(uint32_t t_ms){
+  uint8_t* p = s_buf;
+  s_t0_ms = t_ms;
+  s_prev_s = t_ms / 1000u;
+  s_prev_vdd = s_prev_temp = s_prev_humi = s_prev_lux = 0;
+  *p++ = TLM_FMT_VERSION;
+  p = put_uv(p, ++s_seq);
+  p = put_uv(p, s_prev_s);
+  s_len = (uint16_t)(p - s_buf);
+}
+
+int Tlm_Add(const Tlm_Sample_t* s){
+  if (!s) return -1;
+  if (s_cnt && s_len + TLM_REC_MAX > TLM_MAX_BYTES && tlm_close(s->t_ms) < 0){
+    s_dropped++;                             /* 放不下，上一包又还在发送途中 */
+    return -1;
+  }
+  if (!s_cnt) tlm_open(s->t_ms);
+
+  uint8_t* p = &s_buf[s_len];
+  uint32_t t_s = s->t_ms / 1000u;
+  *p++ = (uint8_t)(s->flags & (TLM_HAS_DHT | TLM_HAS_LUX));
+  p = put_uv(p, t_s - s_prev_s);
+  s_prev_s = t_s;
+  p = put_delta(p, s->vdd_mv, &s_prev_vdd);
+  if (s->flags & TLM_HAS_DHT){
+    p = put_delta(p, s->temp, &s_prev_temp);
+    p = put_delta(p, s->humi, &s_prev_humi);
+  }
+  if (s->flags & TLM_HAS_LUX) p = put_delta(p, (int32_t)s->lux, &s_prev_lux);
+  s_len = (uint16_t)(p - s_buf);
+  s_cnt++;
+  return 0;
+}
+
+void Tlm_Poll(uint32_t now_ms){
+  if (s_cnt && (s_cnt >= TLM_MAX_SAMPLES || now_ms - s_t0_ms >= TLM_MAX_AGE_MS))
+    (void)tlm_close(now_ms);
+  if (s_tx_state == TX_READY && (int32_t)(now_ms - s_tx_next_ms) >= 0){
+    if (NB_SendBinAsync(s_tx, s_tx_len, tlm_done, NULL) == 0) s_tx_state = TX_BUSY;
+    else s_tx_next_ms = now_ms + TLM_RETRY_MS;    /* NB 未就绪或队列满 */
+  }
+}
@@ -0,0 +1,73 @@
+#include "ui_refresh.h"
+#include "ssd1306.h"
+
+#define UI_FRAME_MS   (1000u / UI_MAX_FPS)
+#define UI_STATS_MS   1000u
+
+static uint32_t s_pending;          /* 待处理事件位 */
+static uint32_t s_first_ms;         /* 最早一个待处理事件的时刻 */
+static uint32_t s_last_ms;          /* 上一帧的时刻 */
+static uint8_t  s_started;
+
+/* 统计窗口 */
+static uint32_t s_win_ms;
+static uint32_t s_win_frames;
+static uint32_t s_win_cycles;       /* 窗口起点的 SSD1306 busy_cycles */
+static uint16_t s_win_latency;
+static UI_RefreshStats_t s_stats;
+
+void UI_Post(uint32_t ev){
+  if (!ev) return;
+  if (!s_pending) s_first_ms = HAL_GetTick();
+  s_pending |= ev;
+  s_stats.events++;
+}
+
+static void ui_stats_roll(uint32_t now){
+  uint32_t el = now - s_win_ms;
+  if (el < UI_STATS_MS) return;
+  uint32_t cyc = SSD1306_GetStats()->busy_cycles;
+  uint32_t us  = (cyc - s_win_cycles) / (SystemCoreClock / 1000000u);
+  s_stats.fps_x10      = (uint16_t)((s_win_frames * 10000u + el / 2) / el);
+  s_stats.spi_busy_us  = us;
+  s_stats.spi_permille = (uint16_t)(us / el);           /* µs/ms = ‰ */
+  s_stats.latency_ms   = s_win_latency;
+  s_win_ms      = now;
+  s_win_frames  = 0;
+  s_win_cycles  = cyc;
+  s_win_latency = 0;
+}
+
+uint32_t UI_RefreshDue(uint32_t now){
+  if (!s_started){
+    s_started    = 1;
+    s_last_ms    = now - UI_FRAME_MS;
+    s_win_ms     = now;
+    s_win_cycles = SSD1306_GetStats()->busy_cycles;
+    if (!s_pending){ s_pending = UI_EV_IDLE; s_first_ms = now; }   /* 第一圈总要画一帧 */
+  }
+  ui_stats_roll(now);
+
+  uint32_t since = now - s_last_ms;
+#if UI_IDLE_MS
+  if (!s_pending && since >= UI_IDLE_MS){ s_pending = UI_EV_IDLE; s_first_ms = now; }
+#endif
+  if (!s_pending || since < UI_FRAME_MS) return 0;
+
+  /* 事件可能是在本圈取 now 之后才 Post 的，此时按 0 算 */
+  uint32_t lat = ((int32_t)(now - s_first_ms) > 0) ? now - s_first_ms : 0;
+  if (lat > s_win_latency) s_win_latency = (uint16_t)(lat > 0xFFFFu ? 0xFFFFu : lat);
+  uint32_t ev = s_pending;
+  s_pending = 0;
+  return ev;
+}
+
+void UI_RefreshDone(uint32_t now){
+  s_last_ms = now;
+  s_win_frames++;
+  s_stats.frames++;
+}
+
+const UI_RefreshStats_t* UI_GetRefreshStats(void){
+  return &s_stats;
+}
@@ -0,0 +1,344 @@
+#include "ui_widget.h"
+#include "ui_sprites.h"
+#include "ssd1306.h"
+#include "ssd1306_utf8.h"
+#include <string.h>
+
+#include "ui_sprites.inc"
+
+#define UI_DIRTY_FULL    0x01
+#define UI_DIRTY_APPEND  0x02        /* 曲线：只来了新样本，左移后画新列即可 */
+
+static UI_Stats_t s_stats;
+
+/* 整数转十进制（替代 snprintf，值没变就不会走到这里） */
+static char* ui_put_num(char* p, char* end, int32_t v, uint8_t width, uint8_t decimals){
+  char tmp[12]; int n = 0;
+  uint32_t u = (v < 0) ? (uint32_t)(-(v + 1)) + 1u : (uint32_t)v;
+  do {
+    tmp[n++] = (char)('0' + u % 10u); u /= 10u;
+    if (decimals && n == decimals) tmp[n++] = '.';
+  } while (u || (decimals && n < decimals + 2));   /* 有小数时整数部分至少一位 */
+  if (v < 0) tmp[n++] = '-';
+  for (int pad = width - n; pad > 0 && p < end; --pad) *p++ = ' ';
+  while (n && p < end) *p++ = tmp[--n];
+  return p;
+}
+
+static char* ui_put_str(char* p, char* end, const char* s){
+  while (s && *s && p < end) *p++ = *s++;
+  return p;
+}
+
+void UI_SetText(UI_Widget_t* w, const char* s){
+  if (!w) return;
+  if (!s) s = "";
+  if (w->str_id < 0 && !w->has_value && strncmp(w->text, s, UI_TEXT_MAX - 1) == 0) return;
+  strncpy(w->text, s, UI_TEXT_MAX - 1);
+  w->text[UI_TEXT_MAX - 1] = 0;
+  w->str_id = -1;
+  w->has_value = 0;
+  w->dirty = 1;
+}
+
+void UI_SetTextId(UI_Widget_t* w, UiStr_t id){
+  if (!w || w->str_id == (int16_t)id) return;
+  w->str_id = (int16_t)id;
+  w->has_value = 0;
+  w->dirty = 1;
+}
+
+void UI_SetNumber(UI_Widget_t* w, int32_t v){
+  if (!w || (w->has_value && w->value == v)) return;
+  char* p = w->text; char* end = w->text + UI_TEXT_MAX - 1;
+  p = ui_put_str(p, end, w->prefix);
+  p = ui_put_num(p, end, v, w->width, w->decimals);
+  p = ui_put_str(p, end, w->suffix);
+  *p = 0;
+  w->value = v;
+  w->has_value = 1;
+  w->str_id = -1;
+  w->dirty = 1;
+}
+
+void UI_SetIcon(UI_Widget_t* w, int32_t state){
+  if (!w || w->value == state) return;
+  w->value = state;
+  w->dirty = 1;
+}
+
+void UI_Animate(UI_Widget_t* w, uint8_t on){
+  if (!w || !w->sprite) return;
+  if (!on){ UI_SetIcon(w, 0); return; }
+  UI_SetIcon(w, (w->value > 0 && w->value < w->sprite->frames) ? w->value + 1 : 1);
+}
+
+void UI_Invalidate(UI_Widget_t* w){
+  if (w) w->dirty = 1;
+}
+
+/* ---------------------------- 曲线 ---------------------------- */
+static int16_t chart_at(const UI_Chart_t* c, uint8_t i){       /* i=0 最旧 */
+  int k = c->head - c->count + i;
+  if (k < 0) k += c->cap;
+  return c->buf[k];
+}
+
+static void chart_rescan(UI_Chart_t* c){
+  c->min = c->max = chart_at(c, 0);
+  for (uint8_t i = 1; i < c->count; ++i){
+    int16_t v = chart_at(c, i);
+    if (v < c->min) c->min = v;
+    if (v > c->max) c->max = v;
+  }
+}
+
+static int16_t chart_clamp(int32_t v){
+  return (int16_t)((v < INT16_MIN) ? INT16_MIN : (v > INT16_MAX) ? INT16_MAX : v);
+}
+
+/* 纵轴：数据跨度（至少 min_span）上下各留 1/4 余量；数据出界或跨度不到纵轴的 1/3 才重算。
+ * 返回 1=纵轴变了（要整块重画） */
+static uint8_t chart_fit(UI_Chart_t* c){
+  int32_t span = (int32_t)c->max - c->min;
+  int32_t need = (span > c->min_span) ? span : c->min_span;
+  if (need < 1) need = 1;
+  int32_t range = (int32_t)c->hi - c->lo;
+  if (range > 0 && c->min >= c->lo && c->max <= c->hi && range <= 3 * need) return 0;
+  int32_t lo = ((int32_t)c->min + c->max) / 2 - need / 2 - need / 4;
+  c->lo = chart_clamp(lo);
+  c->hi = chart_clamp(lo + need + 2 * (need / 4) + 1);
+  return 1;
+}
+
+void UI_ChartPush(UI_Widget_t* w, int16_t v){
+  if (!w || !w->chart || !w->chart->cap) return;
+  UI_Chart_t* c = w->chart;
+  uint8_t rescan = (c->count == 0);
+  if (c->count == c->cap){
+    int16_t old = c->buf[c->head];                 /* 被挤掉的最旧样本 */
+    if (old == c->min || old == c->max) rescan = 1;
+  }else{
+    c->count++;
+  }
+  c->buf[c->head] = v;
+  c->head = (uint8_t)((c->head + 1 == c->cap) ? 0 : c->head + 1);
+  if (rescan){
+    chart_rescan(c);
+  }else{
+    if (v < c->min) c->min = v;
+    if (v > c->max) c->max = v;
+  }
+  if (c->pending < c->cap) c->pending++;
+  w->dirty |= chart_fit(c) ? UI_DIRTY_FULL : UI_DIRTY_APPEND;
+}
+
+static int chart_row(const UI_Widget_t* w, int16_t v){
+  const UI_Chart_t* c = w->chart;
+  return w->y + (w->h - 1) - (int)(((int32_t)v - c->lo) * (w->h - 1) / ((int32_t)c->hi - c->lo));
+}
+
+/* 第 i 个样本画在一列上：从前一个样本的高度竖线连到本样本，连起来就是折线 */
+static void chart_col(const UI_Widget_t* w, uint8_t i){
+  const UI_Chart_t* c = w->chart;
+  int x  = w->x + w->w - c->count + i;             /* 最新样本在最右列 */
+  if (x < w->x) return;
+  int y1 = chart_row(w, chart_at(c, i));
+  int y0 = i ? chart_row(w, chart_at(c, i - 1)) : y1;
+  if (y0 > y1){ int t = y0; y0 = y1; y1 = t; }
+  SSD1306_DrawVLine(x, y0, y1 - y0 + 1, 1);
+}
+
+static void chart_draw(UI_Widget_t* w){
+  UI_Chart_t* c = w->chart;
+  uint8_t from = 0;
+  if (w->dirty & UI_DIRTY_FULL){
+    SSD1306_FillRect(w->x, w->y, w->w, w->h, 0);
+  }else{
+    SSD1306_ShiftLeft(w->x, w->y, w->w, w->h, c->pending);
+    from = (uint8_t)(c->count - c->pending);
+    if (c->count >= w->w && from){
+      /* 最左列原来连着已被挤掉的样本，改成只画它自己 */
+      SSD1306_FillRect(w->x, w->y, 1, w->h, 0);
+      chart_col(w, 0);
+    }
+  }
+  for (uint8_t i = from; i < c->count; ++i) chart_col(w, i);
+  c->pending = 0;
+}
+
+static void ui_draw_line(const UI_Widget_t* w, int y, const char* s){
+  if (w->align == UI_ALIGN_CENTER){
+    int x = w->x + (w->w - SSD1306_StringWidth6x8(s)) / 2; if (x < w->x) x = w->x;
+    SSD1306_DrawString(x, y, s);
+  }else{
+    SSD1306_DrawString(w->x, y, s);
+  }
+}
+
+static void ui_draw(UI_Widget_t* w){
+  if (w->kind == UI_W_CHART){
+    if (w->chart) chart_draw(w);
+    return;
+  }
+  if (w->kind == UI_W_SPRITE){
+    /* 整帧覆盖写，不用先清 */
+    const UI_Sprite_t* sp = w->sprite;
+    if (w->value > 0 && sp && sp->frames){
+      uint8_t f = (uint8_t)((w->value - 1) % sp->frames);
+      SSD1306_BlitColumns(w->x, w->y, sp->cols + f * sp->w, sp->w, 0xFF);
+    }else{
+      SSD1306_FillRect(w->x, w->y, w->w, w->h, 0);
+    }
+    return;
+  }
+  SSD1306_FillRect(w->x, w->y, w->w, w->h, 0);
+  switch (w->kind){
+    case UI_W_TEXT:
+      if (w->str_id >= 0){
+        int x = w->x;
+        if (w->align == UI_ALIGN_CENTER){
+          x += (w->w - OLED_TextWidth((UiStr_t)w->str_id)) / 2; if (x < w->x) x = w->x;
+        }
+        OLED_DrawText(x, w->y, (UiStr_t)w->str_id);
+      }else if (w->font && w->has_value && BigFont_CanDraw(w->text)){
+        BigFont_t f = (BigFont_t)(w->font - 1);
+        int x = w->x;
+        if (w->align == UI_ALIGN_CENTER){
+          x += (w->w - BigFont_TextWidth(f, w->text)) / 2; if (x < w->x) x = w->x;
+        }
+        BigFont_DrawText(x, w->y, f, w->text);
+      }else if (w->text[0]){
+        ui_draw_line(w, w->y + (w->h - 8) / 2, w->text);
+      }
+      break;
+    case UI_W_TEXT2: {
+      /* 与原 draw_nb_two_lines 一致：按 21 字硬切两行，不加省略号，空串显示 "--" */
+      const int per_line = SSD1306_WIDTH / 6;
+      char l[SSD1306_WIDTH / 6 + 1];
+      size_t len = strlen(w->text);
+      if (len == 0){ ui_draw_line(w, w->y, "--"); break; }
+      strncpy(l, w->text, per_line); l[per_line] = 0;
+      ui_draw_line(w, w->y, l);
+      if (len > (size_t)per_line){
+        strncpy(l, w->text + per_line, per_line); l[per_line] = 0;
+        ui_draw_line(w, w->y + 8, l);
+      }
+      break;
+    }
+    case UI_W_ICON:
+      if (w->value && w->draw) w->draw(w->x, w->y, w->value);
+      break;
+    default: break;
+  }
+}
+
+uint8_t UI_Render(const UI_Page_t* pg){
+  if (!pg) return 0;
+  uint32_t t0 = SSD1306_CYCCNT();
+  uint8_t drawn = 0;
+  for (uint8_t i = 0; i < pg->count; ++i){
+    UI_Widget_t* w = pg->items[i];
+    if (!w->dirty) continue;
+    ui_draw(w);
+    w->dirty = 0;
+    drawn++;
+  }
+  uint32_t dt = SSD1306_CYCCNT() - t0;
+  s_stats.last_cycles = dt;
+  s_stats.last_drawn  = drawn;
+  if (dt > s_stats.max_cycles) s_stats.max_cycles = dt;
+  return drawn;
+}
+
+#if UI_PAGE_CACHE
+/* ---------------------------- 页模板 ---------------------------- */
+#define UI_TPL_NONE  0xFFFFu         /* 池不够，这页不缓存 */
+
+typedef struct {
+  const UI_Page_t* pg;
+  uint16_t off;                     /* 在 s_tpl_pool 里的起点 */
+  uint8_t  lo[SSD1306_PAGES];       /* 每个显存页的非零列区间，lo>hi 表示空 */
+  uint8_t  hi[SSD1306_PAGES];
+} UI_Tpl_t;
+
+static UI_Tpl_t s_tpl[UI_TPL_PAGES];
+static uint8_t  s_tpl_pool[UI_TPL_POOL_BYTES];
+
+/* 在刚清空的帧缓冲上只画固定控件，记下各页非零区间并存进池；池不够就只登记不存 */
+static void tpl_build(const UI_Page_t* pg){
+  UI_Tpl_t* t = &s_tpl[s_stats.tpl_pages++];
+  t->pg = pg;
+  t->off = UI_TPL_NONE;
+  for (uint8_t i = 0; i < pg->count; ++i){
+    UI_Widget_t* w = pg->items[i];
+    if (w->chrome){ ui_draw(w); w->dirty = 0; }
+  }
+  const uint8_t* fb = SSD1306_GetBuffer();
+  uint16_t need = 0;
+  for (uint8_t p = 0; p < SSD1306_PAGES; ++p){
+    const uint8_t* row = fb + p * SSD1306_WIDTH;
+    int lo = 0, hi = SSD1306_WIDTH - 1;
+    while (lo <= hi && !row[lo]) lo++;
+    while (hi >= lo && !row[hi]) hi--;
+    t->lo[p] = (uint8_t)((lo <= hi) ? lo : 1);
+    t->hi[p] = (uint8_t)((lo <= hi) ? hi : 0);
+    if (lo <= hi) need += (uint16_t)(hi - lo + 1);
+  }
+  if (s_stats.tpl_bytes + need > UI_TPL_POOL_BYTES) return;
+  t->off = s_stats.tpl_bytes;
+  uint8_t* d = &s_tpl_pool[t->off];
+  for (uint8_t p = 0; p < SSD1306_PAGES; ++p){
+    if (t->lo[p] > t->hi[p]) continue;
+    uint16_t n = (uint16_t)(t->hi[p] - t->lo[p] + 1);
+    memcpy(d, fb + p * SSD1306_WIDTH + t->lo[p], n);
+    d += n;
+  }
+  s_stats.tpl_bytes += need;
+}
+
+/* 把这页的固定控件放进（已清空的）帧缓冲：有模板就拷，第一次来就现建。
+ * 返回 1=固定控件已在帧缓冲里；0=这页不缓存，需要照常画 */
+static uint8_t tpl_apply(const UI_Page_t* pg){
+  for (uint8_t k = 0; k < s_stats.tpl_pages; ++k){
+    const UI_Tpl_t* t = &s_tpl[k];
+    if (t->pg != pg) continue;
+    if (t->off == UI_TPL_NONE) return 0;
+    uint8_t* fb = SSD1306_GetBuffer();
+    const uint8_t* src = &s_tpl_pool[t->off];
+    for (uint8_t p = 0; p < SSD1306_PAGES; ++p){
+      if (t->lo[p] > t->hi[p]) continue;
+      uint16_t n = (uint16_t)(t->hi[p] - t->lo[p] + 1);
+      memcpy(fb + p * SSD1306_WIDTH + t->lo[p], src, n);
+      src += n;
+    }
+    return 1;
+  }
+  if (s_stats.tpl_pages >= UI_TPL_PAGES) return 0;
+  tpl_build(pg);
+  return 1;
+}
+#endif
+
+void UI_Show(const UI_Page_t* pg){
+  if (!pg) return;
+  uint32_t t0 = SSD1306_CYCCNT();
+  SSD1306_Fill(0);
+#if UI_PAGE_CACHE
+  uint8_t chrome_done = tpl_apply(pg);
+#else
+  uint8_t chrome_done = 0;
+#endif
+  for (uint8_t i = 0; i < pg->count; ++i){
+    UI_Widget_t* w = pg->items[i];
+    w->dirty = (w->chrome && chrome_done) ? 0 : 1;
+  }
+  UI_Render(pg);
+  uint32_t dt = SSD1306_CYCCNT() - t0;
+  s_stats.show_cycles = dt;
+  if (dt > s_stats.show_max) s_stats.show_max = dt;
+}
+
+const UI_Stats_t* UI_GetStats(void){
+  return &s_stats;
+}
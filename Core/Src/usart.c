@@ -25,6 +25,7 @@
 /* USER CODE END 0 */
 
 UART_HandleTypeDef huart1;
+DMA_HandleTypeDef hdma_usart1_rx;
 
 /* USART1 init function */
 
@@ -44,8 +45,7 @@ void MX_USART1_UART_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN MX_USART1_Init 2 */
-  // 说明：接收“点火”仍然由 main.c 里的 BT_UART_Start() 负责，
-  // 以避免跨文件访问 static bt_rx_byte 带来的链接问题。
+  UART1_RxStart();     // 接收一直开着：循环 DMA 写进环形缓冲，见文件末尾
   /* USER CODE END MX_USART1_Init 2 */
 
 }
@@ -79,6 +79,25 @@ void HAL_UART_MspInit(UART_HandleTypeDef* uartHandle)
 
   /* USER CODE BEGIN USART1_MspInit 1 */
 
+    /* USART1_RX DMA：DMA1_Channel5，循环模式（见 UART1_RxStart） */
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    hdma_usart1_rx.Instance = DMA1_Channel5;
+    hdma_usart1_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_usart1_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_usart1_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_usart1_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_usart1_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_usart1_rx.Init.Mode = DMA_CIRCULAR;
+    hdma_usart1_rx.Init.Priority = DMA_PRIORITY_MEDIUM;
+    if (HAL_DMA_Init(&hdma_usart1_rx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+    __HAL_LINKDMA(uartHandle,hdmarx,hdma_usart1_rx);
+
+    HAL_NVIC_SetPriority(DMA1_Channel5_IRQn, 1, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel5_IRQn);
+
   HAL_NVIC_SetPriority(USART1_IRQn, 1, 0);
   HAL_NVIC_EnableIRQ(USART1_IRQn);
 
@@ -104,10 +123,60 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* uartHandle)
     HAL_GPIO_DeInit(GPIOA, GPIO_PIN_9|GPIO_PIN_10);
 
   /* USER CODE BEGIN USART1_MspDeInit 1 */
+    HAL_DMA_DeInit(uartHandle->hdmarx);
+    HAL_NVIC_DisableIRQ(DMA1_Channel5_IRQn);
 
   /* USER CODE END USART1_MspDeInit 1 */
   }
 }
 
 /* USER CODE BEGIN 1 */
+
+/* ---- USART1 接收环形缓冲 ----
+ * DMA 按循环模式一直往 s_rx_ring 里写，写指针就是 “缓冲长度 - DMA 剩余计数”，不占 CPU；
+ * 读指针只由主循环一侧改。两边各用一个累计字节数（不取模），差值就是未读字节，
+ * 超过缓冲长度说明读得太慢、最旧的数据已被覆盖，整段丢掉重新对齐。 */
+static uint8_t s_rx_ring[UART1_RX_RING];
+static volatile uint32_t s_rx_lap = 0;      /* 已写满的圈数 × 缓冲长度（DMA 写完一圈的回调里加） */
+static uint32_t s_rx_rd = 0;                /* 已读出的累计字节数 */
+static uint32_t s_rx_dropped = 0;           /* 溢出丢掉的字节数（调试看） */
+
+void UART1_RxStart(void){
+  s_rx_lap = 0; s_rx_rd = 0;
+  if (HAL_UART_Receive_DMA(&huart1, s_rx_ring, UART1_RX_RING) != HAL_OK) return;
+  /* 帧错误/噪声在 HAL 里会中止 DMA 接收；关掉这两个错误中断，坏字节照收，由上层按行丢弃 */
+  __HAL_UART_DISABLE_IT(&huart1, UART_IT_PE);
+  __HAL_UART_DISABLE_IT(&huart1, UART_IT_ERR);
+}
+
+/* DMA 已写入的累计字节数。回绕后回调尚未执行的那几个周期里会少算一圈，
+ * 这时读侧看到的是 “写 < 读”，按没有新数据处理，回调跑完自然恢复。 */
+static uint32_t uart1_rx_written(void){
+  uint32_t lap, pos;
+  do {
+    lap = s_rx_lap;
+    pos = UART1_RX_RING - __HAL_DMA_GET_COUNTER(&hdma_usart1_rx);
+  } while (lap != s_rx_lap);
+  return lap + pos;
+}
+
+uint16_t UART1_RxAvailable(void){
+  uint32_t w = uart1_rx_written();
+  if ((int32_t)(w - s_rx_rd) <= 0) return 0;
+  if (w - s_rx_rd > UART1_RX_RING){ s_rx_dropped += w - s_rx_rd; s_rx_rd = w; return 0; }
+  return (uint16_t)(w - s_rx_rd);
+}
+
+int UART1_RxGetc(void){
+  if (!UART1_RxAvailable()) return -1;
+  uint8_t c = s_rx_ring[s_rx_rd % UART1_RX_RING];
+  s_rx_rd++;
+  return c;
+}
+
+/* 循环 DMA 写完一圈（HAL 在 TC 中断里调用）；半圈回调不用 */
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart){
+  if (huart == &huart1) s_rx_lap += UART1_RX_RING;
+}
+
 /* USER CODE END 1 */
@@ -0,0 +1,123 @@
+/* 16x16 字库整表基准：GB2312 一级字 2500 个（test/host/gen_font16_bench.py 生成，
+ * 经 tools/font16_convert.py 压成与目标板相同格式的 .inc），直接包含 font16.c 以便测内部函数。
+ * 查找：改动前的逐个比对线性扫描 vs 现在的有序索引二分，表内全部码点 + 同样多的表外码点。
+ * 压缩：每个字解压后必须与原始点阵逐字节相同；统计压缩率（真字、合成字分开）、
+ * 单字解压耗时，以及经 Font16_FindGlyph 的缓存命中 / 未命中耗时。 */
+#include "../Core/Src/font16.c"
+#include "host_test.h"
+#include <string.h>
+
+#include "font16_bench_rows.h"
+
+#define N_ROWS (sizeof(BENCH_ROWS) / sizeof(BENCH_ROWS[0]))
+
+static uint16_t s_hit_keys[N_ROWS], s_miss_keys[N_ROWS];
+static volatile int s_sink;
+
+/* 改动前的查找：从头逐个比对 */
+static int linear_index(uint16_t key){
+  for (unsigned i = 0; i < FONT16_COUNT; ++i) if (FONT16_CODES[i] == key) return (int)i;
+  return -1;
+}
+
+static void b_linear(void* a){ const uint16_t* k = a; int s = 0; for (unsigned i = 0; i < N_ROWS; ++i) s += linear_index(k[i]); s_sink = s; }
+static void b_binary(void* a){ const uint16_t* k = a; int s = 0; for (unsigned i = 0; i < N_ROWS; ++i) s += font16_index(k[i]); s_sink = s; }
+
+/* 行优先（高位在左）→ 页格式，与 tools/font16_convert.py 的 rows_to_pages 相同 */
+static void rows_to_pages(const uint8_t rows[32], uint8_t out[32]){
+  memset(out, 0, 32);
+  for (int r = 0; r < 16; ++r){
+    unsigned bits = (unsigned)rows[r * 2] << 8 | rows[r * 2 + 1];
+    for (int c = 0; c < 16; ++c)
+      if (bits & (0x8000u >> c)) out[(r >> 3) * 16 + c] |= (uint8_t)(1u << (r & 7));
+  }
+}
+
+static void b_unpack(void* a){
+  (void)a;
+  uint8_t out[32];
+  int s = 0;
+  for (unsigned i = 0; i < FONT16_COUNT; ++i){ font16_unpack(&FONT16_Z[FONT16_OFFS[i]], out); s += out[7]; }
+  s_sink = s;
+}
+/* 整表乱序取一遍：槽位远少于字数，几乎全是未命中（二分 + 解压 + 换出） */
+static void b_find_miss(void* a){ const uint16_t* k = a; int s = 0; for (unsigned i = 0; i < N_ROWS; ++i) s += Font16_FindGlyph(k[i])[0]; s_sink = s; }
+/* 一屏两行 16 个字（= 缓存槽数）反复取：全部命中 */
+static void b_find_hit(void* a){ const uint16_t* k = a; int s = 0; for (unsigned i = 0; i < FONT16_CACHE_SLOTS; ++i) s += Font16_FindGlyph(k[i])[0]; s_sink = s; }
+
+/* 打乱顺序，免得按码点顺序查时分支预测替二分占便宜 */
+static void shuffle(uint16_t* k, unsigned n){
+  uint32_t r = 12345;
+  for (unsigned i = n - 1; i > 0; --i){
+    r = r * 1103515245u + 12345u;
+    unsigned j = (r >> 8) % (i + 1);
+    uint16_t t = k[i]; k[i] = k[j]; k[j] = t;
+  }
+}
+
+int main(void){
+  CHECK_EQ(FONT16_COUNT, N_ROWS);
+
+  /* 表外码点：相邻两字之间的空档，以及一级字以外的常见区间（ASCII、假名、全角符号） */
+  unsigned nm = 0;
+  for (unsigned i = 0; i + 1 < FONT16_COUNT && nm < N_ROWS; ++i)
+    if (FONT16_CODES[i + 1] - FONT16_CODES[i] > 1) s_miss_keys[nm++] = (uint16_t)(FONT16_CODES[i] + 1);
+  for (uint16_t u = 0x3041; nm < N_ROWS; ++u) s_miss_keys[nm++] = (uint16_t)(u < 0x3100 ? u : 0xFF01 + (u & 0x5F));
+
+  for (unsigned i = 0; i < N_ROWS; ++i){
+    s_hit_keys[i] = BENCH_ROWS[i].code;
+    CHECK_EQ(FONT16_CODES[i], BENCH_ROWS[i].code);
+    CHECK_EQ(font16_index(BENCH_ROWS[i].code), (int)i);
+    CHECK_EQ(font16_index(s_miss_keys[i]), -1);
+    CHECK_EQ(linear_index(s_miss_keys[i]), -1);
+  }
+  CHECK_EQ(font16_index(0), -1);
+  CHECK_EQ(font16_index(0xFFFF), -1);
+  shuffle(s_hit_keys, N_ROWS);
+  shuffle(s_miss_keys, N_ROWS);
+
+  double lh = Host_BenchNs(b_linear, s_hit_keys,  20) / N_ROWS;
+  double bh = Host_BenchNs(b_binary, s_hit_keys,  2000) / N_ROWS;
+  double lm = Host_BenchNs(b_linear, s_miss_keys, 20) / N_ROWS;
+  double bm = Host_BenchNs(b_binary, s_miss_keys, 2000) / N_ROWS;
+  printf("字库 %u 字，查找 ns/次：\n", (unsigned)FONT16_COUNT);
+  printf("  表内  线性 %8.1f  二分 %6.1f  %.0fx\n", lh, bh, lh / bh);
+  printf("  表外  线性 %8.1f  二分 %6.1f  %.0fx\n", lm, bm, lm / bm);
+
+  /* 解压正确性与压缩率 */
+  unsigned z_real = 0, z_syn = 0, n_real = 0, z_min = 255, z_max = 0;
+  for (unsigned i = 0; i < N_ROWS; ++i){
+    uint8_t want[32], got[32];
+    rows_to_pages(BENCH_ROWS[i].rows, want);
+    font16_unpack(&FONT16_Z[FONT16_OFFS[i]], got);
+    if (memcmp(want, got, 32)){ fprintf(stderr, "U+%04X 解压不对\n", BENCH_ROWS[i].code); Host_FailCount++; }
+    unsigned z = FONT16_OFFS[i + 1] - FONT16_OFFS[i];
+    if (BENCH_ROWS[i].real){ z_real += z; n_real++; } else z_syn += z;
+    if (z < z_min) z_min = z;
+    if (z > z_max) z_max = z;
+  }
+  unsigned raw = 32 * FONT16_COUNT, z_all = FONT16_OFFS[FONT16_COUNT];
+  unsigned index = sizeof(FONT16_CODES) + sizeof(FONT16_OFFS);
+  CHECK_EQ(z_all, z_real + z_syn);
+  CHECK(z_all < raw);
+  printf("压缩：点阵 %u -> %u 字节（%.1f%%），每字 %u~%u 字节；加码点/偏移索引 %u 字节共 %.1f%%\n",
+         raw, z_all, 100.0 * z_all / raw, z_min, z_max, index, 100.0 * (z_all + index) / (raw + sizeof(FONT16_CODES)));
+  if (n_real) printf("  真字 %u 个 %.1f%%，合成字 %u 个 %.1f%%\n",
+                     n_real, 100.0 * z_real / (32 * n_real), (unsigned)(FONT16_COUNT - n_real), 100.0 * z_syn / (32 * (FONT16_COUNT - n_real)));
+
+  /* 解压与缓存耗时 */
+  double un = Host_BenchNs(b_unpack, NULL, 200) / FONT16_COUNT;
+  double fm = Host_BenchNs(b_find_miss, s_hit_keys, 200) / N_ROWS;
+  double fh = Host_BenchNs(b_find_hit, s_hit_keys, 200000) / FONT16_CACHE_SLOTS;
+  printf("解压 %.1f ns/字；Font16_FindGlyph 未命中 %.1f ns/字，命中 %.1f ns/字\n", un, fm, fh);
+
+  /* 缓存：16 个字第一遍全部未命中，之后全部命中 */
+  memset(s_cache, 0, sizeof(s_cache));
+  s_stats.hits = s_stats.misses = 0;
+  for (int rep = 0; rep < 3; ++rep)
+    for (unsigned i = 0; i < FONT16_CACHE_SLOTS; ++i) CHECK(Font16_FindGlyph(s_hit_keys[i]) != NULL);
+  CHECK_EQ(Font16_GetStats()->misses, FONT16_CACHE_SLOTS);
+  CHECK_EQ(Font16_GetStats()->hits, 2 * FONT16_CACHE_SLOTS);
+
+  return Host_Failures() != 0;
+}
@@ -0,0 +1,105 @@
+/* 5x7 字形按页列直写（SSD1306_BlitColumns）与原来逐点 DrawPixel 的对比：
+ * 先验证两者在各种 y 相位、左右裁剪下画出的帧缓冲逐字节相同，再比较每串耗时。
+ * 字串取全部 95 个可显示 ASCII 和界面上实际出现的文字，而不是几个示例字。 */
+#include "ssd1306.h"
+#include "host_test.h"
+#include "mock_oled.h"
+#include <string.h>
+
+/* 改动前的画法：每字 35 次 DrawPixel。字模从 SSD1306_DrawChar 画出的结果里读回，不另抄一份 */
+static uint8_t s_font[95][5];
+
+static void load_font(void){
+  uint8_t* fb = SSD1306_GetBuffer();
+  for (int c = 0x20; c <= 0x7E; ++c){
+    SSD1306_Fill(0);
+    SSD1306_DrawChar(0, 0, (char)c);
+    memcpy(s_font[c - 0x20], fb, 5);
+  }
+}
+
+static void ref_char(int x, int y, char c){
+  if (c < 0x20 || c > 0x7E) c = '?';
+  const uint8_t* col = s_font[c - 0x20];
+  for (int i = 0; i < 5; i++){
+    uint8_t bits = col[i];
+    for (int j = 0; j < 7; j++) SSD1306_DrawPixel((uint16_t)(x + i), (uint16_t)(y + j), (bits >> j) & 1);
+  }
+}
+
+static void ref_string(int x, int y, const char* s){
+  int cx = x;
+  while (*s){
+    if (*s == '\n'){ y += 8; cx = x; s++; continue; }
+    ref_char(cx, y, *s++);
+    cx += 6;
+    if (cx + 6 >= SSD1306_WIDTH){ y += 8; cx = x; }
+  }
+}
+
+/* 界面上真实出现的字串（页面标签、读数、NB/AT 日志、自检页） */
+static const char* const UI_TEXT[] = {
+  "Hello STM32", "DHT11", "Hum:61 %", "BH1750", "NB", "Baud:9600", "VDD=3301 mV",
+  "Temp 23~28 C", "Humi 48~72 %", "Lux 100~500 lx", "LOW VDD!", "VDD=2980mV", "Check 5V/3V3",
+  "NO DHT11", "or wiring error", "BH1750 N/A", "Check ADDR/I2C", "OLED OK",
+  "BH1750 OK  DHT11 OK", "NB loading...", ">AT+QISEND=1,42", "<SEND OK", "<+CEREG: 1",
+  "<+QIURC: \"recv\",1,4", "VDD=3301 T=25C H=61%", "snap: 187 bytes",
+};
+static char s_ascii[96];
+
+typedef struct { const char* s; int x, y; } job_t;
+
+static void run_new(void* a){ const job_t* j = a; SSD1306_DrawString(j->x, j->y, j->s); }
+static void run_ref(void* a){ const job_t* j = a; ref_string(j->x, j->y, j->s); }
+
+/* 同一串同一位置，两种画法结果必须一致 */
+static void same(const char* s, int x, int y){
+  uint8_t want[1024];
+  SSD1306_Fill(0);
+  ref_string(x, y, s);
+  memcpy(want, SSD1306_GetBuffer(), sizeof(want));
+  SSD1306_Fill(0);
+  SSD1306_DrawString(x, y, s);
+  if (memcmp(want, SSD1306_GetBuffer(), sizeof(want))){
+    fprintf(stderr, "\"%s\" @(%d,%d) 与逐点画法不一致\n", s, x, y);
+    Host_FailCount++;
+  }
+}
+
+int main(void){
+  MockOled_Reset();
+  SSD1306_Init();
+  load_font();
+  for (int c = 0x20; c <= 0x7E; ++c) s_ascii[c - 0x20] = (char)c;
+
+  /* 正确性：所有字串 × y 的 8 个相位 × 左右裁剪 */
+  static const int XS[] = { 0, 3, 61, 120, -4 };
+  for (int y = -3; y < 66; ++y){
+    for (size_t k = 0; k < sizeof(XS) / sizeof(XS[0]); ++k){
+      for (size_t i = 0; i < sizeof(UI_TEXT) / sizeof(UI_TEXT[0]); ++i) same(UI_TEXT[i], XS[k], y);
+      same(s_ascii, XS[k], y);
+    }
+  }
+
+  /* 耗时：每串一次 DrawString，ns 与每字 ns */
+  size_t chars = 0;
+  double t_new = 0, t_ref = 0, tu_new = 0, tu_ref = 0;
+  for (size_t i = 0; i < sizeof(UI_TEXT) / sizeof(UI_TEXT[0]); ++i){
+    job_t a = { UI_TEXT[i], 0, 24 }, u = { UI_TEXT[i], 0, 27 };
+    chars  += strlen(UI_TEXT[i]);
+    t_new  += Host_BenchNs(run_new, &a, 20000);
+    t_ref  += Host_BenchNs(run_ref, &a, 20000);
+    tu_new += Host_BenchNs(run_new, &u, 20000);
+    tu_ref += Host_BenchNs(run_ref, &u, 20000);
+  }
+  size_t n = sizeof(UI_TEXT) / sizeof(UI_TEXT[0]);
+  printf("界面字串 %u 条、平均 %.1f 字\n", (unsigned)n, (double)chars / n);
+  printf("  y 对齐   逐点 %7.1f ns/串  按列 %7.1f ns/串  %.1fx\n", t_ref / n, t_new / n, t_ref / t_new);
+  printf("  y 不对齐 逐点 %7.1f ns/串  按列 %7.1f ns/串  %.1fx\n", tu_ref / n, tu_new / n, tu_ref / tu_new);
+
+  job_t all = { s_ascii, 0, 3 };
+  double a_ref = Host_BenchNs(run_ref, &all, 5000), a_new = Host_BenchNs(run_new, &all, 5000);
+  printf("  全部 95 个 ASCII（跨行） 逐点 %.1f ns/字  按列 %.1f ns/字  %.1fx\n", a_ref / 95, a_new / 95, a_ref / a_new);
+
+  return Host_Failures() != 0;
+}
@@ -0,0 +1,51 @@
+/* 把 main.c 拉进主机测试时需要的外设/传感器/NB 桩：只求能链接，返回固定的“正常”读数。
+ * 显示相关的模块（ssd1306、控件、控制台、截屏等）用的是真实源码，不在这里。 */
+#include "main.h"
+#include "adc.h"
+#include "tim.h"
+#include "usart.h"
+#include "soft_i2c.h"
+#include "bh1750.h"
+#include "DHT11.h"
+#include "nb_iot.h"
+#include "telemetry.h"
+
+UART_HandleTypeDef huart1 = { .Init = { .BaudRate = 9600 }, .gState = HAL_UART_STATE_READY };
+TIM_HandleTypeDef  htim2, htim3 = { .ARR = 999 };
+NB_State_t g_nb;
+
+void MX_GPIO_Init(void){}
+void MX_SPI1_Init(void){}
+void MX_I2C1_Init(void){}
+void MX_ADC1_Init(void){}
+void MX_TIM2_Init(void){}
+void MX_TIM3_Init(void){}
+void MX_USART1_UART_Init(void){}
+
+void HAL_GPIO_Init(GPIO_TypeDef* port, GPIO_InitTypeDef* init){ (void)port; (void)init; }
+void HAL_GPIO_WritePin(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState s){
+  if (s) port->ODR |= pin; else port->ODR &= ~(uint32_t)pin;
+}
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* port, uint16_t pin){ return (port->IDR & pin) ? GPIO_PIN_SET : GPIO_PIN_RESET; }
+void HAL_GPIO_TogglePin(GPIO_TypeDef* port, uint16_t pin){ port->ODR ^= pin; }
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef* h, uint32_t ch){ (void)h; (void)ch; return HAL_OK; }
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef* init){ (void)init; return HAL_OK; }
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef* init, uint32_t latency){ (void)init; (void)latency; return HAL_OK; }
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* h, const uint8_t* p, uint16_t n, uint32_t tout){
+  (void)h; (void)p; (void)n; (void)tout; return HAL_OK;
+}
+
+uint32_t Read_VDDA_mV(void){ return 3301; }
+void SoftI2C_Begin(void){}
+int  SoftI2C_Ping(uint8_t addr7){ return addr7 == BH1750_ADDR_LO; }
+HAL_StatusTypeDef BH1750_Init(uint8_t prefer_addr, uint8_t mode){ (void)prefer_addr; (void)mode; return HAL_OK; }
+HAL_StatusTypeDef BH1750_ReadLux(float* lux){ *lux = 123.4f; return HAL_OK; }
+HAL_StatusTypeDef DHT11_Read(DHT11_DataTypeDef* out){ out->temperature = 25; out->humidity = 61; return HAL_OK; }
+
+void NB_SetLogHook(NB_LogHook fn){ (void)fn; }
+void NB_SetRecvHook(NB_RecvHook fn){ (void)fn; }
+int  NB_InitAsync(const char* apn, const char* ip, uint16_t port){ (void)apn; (void)ip; (void)port; return 0; }
+void NB_Poll(void){}
+int  NB_SendLineAsync(const char* line, NB_AtDone done, void* ctx){ (void)line; (void)done; (void)ctx; return 0; }
+int  Tlm_Add(const Tlm_Sample_t* s){ (void)s; return 0; }
+void Tlm_Poll(uint32_t now_ms){ (void)now_ms; }
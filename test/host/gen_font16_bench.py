@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""字库基准用的整表：GB2312 一级字（按区位均匀取 N 个）的 16x16 行优先 C 表。
+
+沙箱/CI 上通常没有中文点阵字体，所以默认字形是按码点定种子拼出来的“笔画”
+（横、竖、撇捺、口字框），笔画数和点数与 tools/font16_src.c 里的真字相当，
+压缩率和解码量与真字同一量级；tools/font16_src.c 里有的字直接用真字。
+给了 --bdf（如 wqy / unifont 16px）时，字体里有的字一律用真字。
+
+输出格式就是 font16_convert.py 认的行优先表（{0x4E00,{32 字节}}），
+同一个文件既喂给 font16_convert.py 生成压缩 .inc，也给基准当原始点阵做比对。
+
+  test/host/gen_font16_bench.py -n 2500 -o build/font16_bench_rows.h
+"""
+import argparse
+import os
+import random
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', 'tools'))
+import font16_convert  # noqa: E402
+
+
+def gb2312_level1():
+    """GB2312 一级字：16~55 区，55 区只到 89 位，共 3755 字"""
+    out = []
+    for q in range(16, 56):
+        for w in range(1, 95):
+            if q == 55 and w > 89:
+                break
+            out.append(ord(bytes([0xA0 + q, 0xA0 + w]).decode('gb2312')))
+    return out
+
+
+def synth(u):
+    """按码点定种子拼一个笔画字：2~4 横、1~3 竖、0~2 撇捺，偶尔一个口字框"""
+    rnd = random.Random(u)
+    px = set()
+
+    def hline(y, x0, x1):
+        px.update((x, y) for x in range(x0, x1 + 1))
+
+    def vline(x, y0, y1):
+        px.update((x, y) for y in range(y0, y1 + 1))
+
+    for _ in range(rnd.randint(2, 4)):
+        x0 = rnd.randint(1, 7)
+        hline(rnd.randint(1, 14), x0, rnd.randint(x0 + 3, 14))
+    for _ in range(rnd.randint(1, 3)):
+        y0 = rnd.randint(0, 7)
+        vline(rnd.randint(2, 13), y0, rnd.randint(y0 + 4, 15))
+    for _ in range(rnd.randint(0, 2)):
+        x, y = rnd.randint(2, 13), rnd.randint(2, 9)
+        dx = rnd.choice((-1, 1))
+        for _ in range(rnd.randint(3, 6)):
+            if 0 <= x < 16 and 0 <= y < 16:
+                px.add((x, y))
+            x += dx
+            y += 1
+    if rnd.random() < 0.3:
+        x0, y0 = rnd.randint(1, 6), rnd.randint(1, 8)
+        x1, y1 = rnd.randint(x0 + 4, 14), rnd.randint(y0 + 3, 14)
+        hline(y0, x0, x1)
+        hline(y1, x0, x1)
+        vline(x0, y0, y1)
+        vline(x1, y0, y1)
+
+    rows = [0] * 32
+    for x, y in px:
+        rows[y * 2 + (x >> 3)] |= 0x80 >> (x & 7)
+    return rows
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('-n', '--count', type=int, default=2500, help='取多少字（最多 3755）')
+    ap.add_argument('--real', default=os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                                   '..', '..', 'tools', 'font16_src.c'),
+                    help='真字来源（行优先 C 表）')
+    ap.add_argument('--bdf', help='可选：16px BDF 字体，有的字用真字')
+    ap.add_argument('-o', '--output', required=True)
+    args = ap.parse_args()
+
+    level1 = gb2312_level1()
+    n = min(args.count, len(level1))
+    codes = {level1[i * len(level1) // n] for i in range(n)}
+
+    real = font16_convert.load(args.real)
+    if args.bdf:
+        real.update(font16_convert.load(args.bdf))
+    codes |= set(real) & {u for u in real if 0x4E00 <= u <= 0x9FFF}
+
+    with open(args.output, 'w', encoding='utf-8', newline='\n') as f:
+        f.write('/* 由 test/host/gen_font16_bench.py 生成：字库基准用的原始点阵（行优先，高位在左）。 */\n\n')
+        f.write('static const struct { uint16_t code; uint8_t real; uint8_t rows[32]; } BENCH_ROWS[] = {\n')
+        n_real = 0
+        for u in sorted(codes):
+            rows = real.get(u)
+            n_real += rows is not None
+            f.write('  {0x%04X,%d,{%s}},\n' % (u, rows is not None,
+                                            ','.join('0x%02X' % b for b in (rows or synth(u)))))
+        f.write('};\n')
+    sys.stderr.write('gen_font16_bench: %d 字（真字 %d）\n' % (len(codes), n_real))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,33 @@
+/* 主机 HAL 替身的公共部分：毫秒节拍、延时、纳秒时钟和几个空的外设寄存器 */
+#include "stm32f1xx_hal.h"
+#include "host_test.h"
+#include <time.h>
+
+uint32_t SystemCoreClock = 72000000u;
+DWT_Type       Host_DWT;
+CoreDebug_Type Host_CoreDebug;
+GPIO_TypeDef   Host_GPIOA, Host_GPIOB, Host_GPIOC;
+
+/* 毫秒节拍不跟真实时间走：测试用 Host_SetTick/HAL_Delay 推进，结果可重复。
+ * 每次读节拍都给 Host_TickHook 一次机会（模拟 DMA 在后台发完），否则忙等会卡死。 */
+static uint32_t s_tick;
+void (*Host_TickHook)(void);
+
+uint32_t HAL_GetTick(void){
+  if (Host_TickHook) Host_TickHook();
+  return s_tick;
+}
+
+void HAL_Delay(uint32_t ms){ s_tick += ms ? ms : 1; }
+
+void Host_SetTick(uint32_t ms){ s_tick = ms; }
+
+HAL_StatusTypeDef HAL_Init(void){ return HAL_OK; }
+void SystemCoreClockUpdate(void){}
+uint32_t HAL_RCC_GetHCLKFreq(void){ return SystemCoreClock; }
+
+uint32_t Host_ClockNs(void){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
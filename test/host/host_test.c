@@ -0,0 +1,75 @@
+#include "host_test.h"
+#include "stm32f1xx_hal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef HOST_GOLDEN_DIR
+#define HOST_GOLDEN_DIR "golden"
+#endif
+
+int Host_FailCount = 0;
+
+int Host_Failures(void){
+  if (Host_FailCount) fprintf(stderr, "共 %d 处失败\n", Host_FailCount);
+  else                printf("全部通过\n");
+  return Host_FailCount;
+}
+
+/* 页格式 → PBM P4：每行 16 字节，最左一点在最高位 */
+static void fb_to_rows(const uint8_t fb[1024], uint8_t start, uint8_t rows[64][16]){
+  memset(rows, 0, 64 * 16);
+  for (int r = 0; r < 64; ++r){
+    int g = (r + start) & 63;                 /* 屏上第 r 行显示 GDDRAM 第 (r+start) 行 */
+    for (int x = 0; x < 128; ++x)
+      if (fb[(g >> 3) * 128 + x] & (1u << (g & 7))) rows[r][x >> 3] |= (uint8_t)(0x80u >> (x & 7));
+  }
+}
+
+static const char PBM_HDR[] = "P4\n128 64\n";
+
+int Host_WritePbm(const char* path, const uint8_t fb[1024], uint8_t start){
+  uint8_t rows[64][16];
+  fb_to_rows(fb, start, rows);
+  FILE* f = fopen(path, "wb");
+  if (!f) return -1;
+  fwrite(PBM_HDR, 1, sizeof(PBM_HDR) - 1, f);
+  fwrite(rows, 1, sizeof(rows), f);
+  return fclose(f);
+}
+
+int Host_CheckGolden(const char* name, const uint8_t fb[1024], uint8_t start){
+  char path[512];
+  snprintf(path, sizeof(path), "%s/%s.pbm", HOST_GOLDEN_DIR, name);
+  const char* upd = getenv("UPDATE_GOLDEN");
+  if (upd && upd[0] == '1'){
+    printf("  金样已更新：%s\n", path);
+    return Host_WritePbm(path, fb, start);
+  }
+
+  uint8_t want[sizeof(PBM_HDR) - 1 + 64 * 16], got[64][16];
+  FILE* f = fopen(path, "rb");
+  size_t n = f ? fread(want, 1, sizeof(want), f) : 0;
+  if (f) fclose(f);
+  fb_to_rows(fb, start, got);
+  if (n == sizeof(want) && !memcmp(want, PBM_HDR, sizeof(PBM_HDR) - 1) &&
+      !memcmp(want + sizeof(PBM_HDR) - 1, got, sizeof(got))) return 0;
+
+  char act[256];
+  snprintf(act, sizeof(act), "%s.actual.pbm", name);
+  Host_WritePbm(act, fb, start);
+  fprintf(stderr, "%s 与金样 %s 不一致（实际画面：%s）\n", name, path, act);
+  Host_FailCount++;
+  return -1;
+}
+
+double Host_BenchNs(void (*fn)(void*), void* arg, unsigned n){
+  double best = 0;
+  fn(arg);
+  for (int round = 0; round < 5; ++round){   /* 取 5 轮里最快的一轮，减少调度抖动 */
+    uint32_t t0 = Host_ClockNs();
+    for (unsigned i = 0; i < n; ++i) fn(arg);
+    double ns = (double)(uint32_t)(Host_ClockNs() - t0) / n;
+    if (round == 0 || ns < best) best = ns;
+  }
+  return best;
+}
@@ -0,0 +1,37 @@
+/* 主机测试的公共小工具：断言、节拍控制、PBM 读写与金样比对、计时 */
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 失败只记数不退出，一次跑完能看到全部不对的地方；main 最后 return Host_Failures() != 0 */
+extern int Host_FailCount;
+#define CHECK(cond) do{ if (!(cond)){ \
+    fprintf(stderr, "%s:%d: CHECK(%s) 失败\n", __FILE__, __LINE__, #cond); Host_FailCount++; } }while(0)
+#define CHECK_EQ(a, b) do{ long long a_ = (long long)(a), b_ = (long long)(b); if (a_ != b_){ \
+    fprintf(stderr, "%s:%d: %s == %lld，期望 %s == %lld\n", __FILE__, __LINE__, #a, a_, #b, b_); Host_FailCount++; } }while(0)
+int Host_Failures(void);              /* 打印汇总，返回失败数 */
+
+/* 毫秒节拍（HAL_GetTick）；Host_TickHook 非空时每次读节拍先调它 */
+void Host_SetTick(uint32_t ms);
+extern void (*Host_TickHook)(void);
+
+/* 屏幕图像：页格式 1024 字节（与 SSD1306 显存相同）。start 为显示起始行，
+ * 写 PBM 时按起始行把 GDDRAM 转成屏上看到的样子（与 tools/oled_snap.py 一致：亮点=1）。 */
+int  Host_WritePbm(const char* path, const uint8_t fb[1024], uint8_t start);
+/* 与金样 test/golden/<name>.pbm 比对：不一致时把实际画面写到 <name>.actual.pbm 并返回非 0。
+ * 环境变量 UPDATE_GOLDEN=1 时改为用实际画面覆盖金样。 */
+int  Host_CheckGolden(const char* name, const uint8_t fb[1024], uint8_t start);
+
+/* 计时：fn 连跑 n 次，返回每次平均纳秒（先热身一轮） */
+double Host_BenchNs(void (*fn)(void*), void* arg, unsigned n);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,141 @@
+#include "mock_oled.h"
+#include "oled_bus.h"
+#include "host_test.h"
+#include <string.h>
+
+#define RAM_COLS 132
+
+static uint8_t s_ram[SSD1306_PAGES][RAM_COLS];
+static uint8_t s_start;
+static MockOled_Stats_t s_st;
+
+/* 命令解析状态 */
+static uint8_t s_col, s_col_lo, s_col_hi = SSD1306_WIDTH - 1;
+static uint8_t s_page, s_page_lo, s_page_hi = SSD1306_PAGES - 1;
+static uint8_t s_cmd, s_argc, s_need, s_args[2];
+static uint8_t s_in_txn;
+
+/* 待完成的 DMA 段 */
+static const uint8_t* s_dma_src;
+static uint16_t s_dma_len;
+static uint8_t  s_dma_data, s_dma_pending;
+static uint8_t  s_dma_enabled = 1, s_auto = 1;
+
+static uint8_t cmd_args(uint8_t c){
+#if SSD1306_CTRL == SSD1306_CTRL_SH1106
+  switch (c){ case 0xD5: case 0xA8: case 0xD3: case 0xAD: case 0xDA: case 0x81: case 0xD9: case 0xDB: return 1; }
+#else
+  switch (c){
+    case 0x21: case 0x22: return 2;
+    case 0xD5: case 0xA8: case 0xD3: case 0x8D: case 0x20: case 0xDA: case 0x81: case 0xD9: case 0xDB: return 1;
+  }
+#endif
+  return 0;
+}
+
+static void cmd_byte(uint8_t b){
+  if (s_need){
+    s_args[s_argc++] = b;
+    if (s_argc < s_need) return;
+    s_need = 0;
+    if (s_cmd == 0x21){ s_col_lo = s_args[0]; s_col_hi = s_args[1]; s_col = s_col_lo; }
+    if (s_cmd == 0x22){ s_page_lo = s_args[0] & 7; s_page_hi = s_args[1] & 7; s_page = s_page_lo; }
+    return;
+  }
+  s_cmd = b; s_argc = 0; s_need = cmd_args(b);
+  if ((b & 0xC0) == 0x40){ s_start = b & 0x3F; s_st.start_seq = s_st.bytes; return; }
+#if SSD1306_CTRL == SSD1306_CTRL_SH1106
+  if ((b & 0xF0) == 0xB0)      s_page = b & 7;
+  else if ((b & 0xF0) == 0x00) s_col = (uint8_t)((s_col & 0xF0) | (b & 0x0F));
+  else if ((b & 0xF0) == 0x10) s_col = (uint8_t)((s_col & 0x0F) | ((b & 0x0F) << 4));
+#endif
+}
+
+static void data_byte(uint8_t b){
+  s_st.last_data_seq = s_st.bytes;
+#if SSD1306_CTRL == SSD1306_CTRL_SH1106
+  if (s_col < RAM_COLS) s_ram[s_page][s_col] = b;     /* 页寻址：写到行尾不回绕 */
+  if (s_col < RAM_COLS - 1) s_col++;
+#else
+  s_ram[s_page][s_col] = b;                           /* 水平寻址：窗口内回绕 */
+  if (++s_col > s_col_hi){ s_col = s_col_lo; if (++s_page > s_page_hi) s_page = s_page_lo; }
+#endif
+}
+
+static void bus_bytes(uint8_t data, const uint8_t* p, uint16_t n){
+  if (!s_in_txn) s_st.errors++;
+  for (uint16_t i = 0; i < n; ++i){
+    s_st.bytes++;
+    if (data){ s_st.data_bytes++; data_byte(p[i]); }
+    else     { s_st.cmd_bytes++;  cmd_byte(p[i]); }
+  }
+}
+
+static void auto_dma(void){
+  if (s_auto && s_dma_pending) MockOled_DmaComplete();
+}
+
+void MockOled_Reset(void){
+  memset(s_ram, 0xA5, sizeof(s_ram));
+  memset(&s_st, 0, sizeof(s_st));
+  s_start = 0;
+  s_col = s_col_lo = 0; s_col_hi = SSD1306_WIDTH - 1;
+  s_page = s_page_lo = 0; s_page_hi = SSD1306_PAGES - 1;
+  s_need = 0; s_in_txn = 0;
+  s_dma_pending = 0; s_dma_enabled = 1; s_auto = 1;
+  Host_TickHook = auto_dma;
+}
+
+void MockOled_SetAutoDma(uint8_t on){ s_auto = on; }
+void MockOled_SetDmaEnabled(uint8_t on){ s_dma_enabled = on; }
+uint8_t MockOled_DmaPending(void){ return s_dma_pending; }
+
+void MockOled_DmaComplete(void){
+  if (!s_dma_pending) return;
+  s_dma_pending = 0;
+  bus_bytes(s_dma_data, s_dma_src, s_dma_len);
+  SSD1306_BusTxDone();
+}
+
+void MockOled_DmaFail(void){
+  if (!s_dma_pending) return;
+  s_dma_pending = 0;
+  SSD1306_BusError();
+}
+
+void MockOled_GetFrame(uint8_t fb[1024]){
+  for (int p = 0; p < SSD1306_PAGES; ++p)
+    memcpy(&fb[p * SSD1306_WIDTH], &s_ram[p][SSD1306_COL_OFFSET], SSD1306_WIDTH);
+}
+
+uint8_t MockOled_StartLine(void){ return s_start; }
+const MockOled_Stats_t* MockOled_GetStats(void){ return &s_st; }
+
+/* ---- oled_bus.h ---- */
+void OLED_Bus_Reset(void){}
+
+void OLED_Bus_Begin(void){
+  if (s_in_txn) s_st.errors++;
+  s_in_txn = 1;
+  s_st.txns++;
+}
+
+void OLED_Bus_End(void){
+  if (!s_in_txn || s_dma_pending) s_st.errors++;     /* DMA 没发完就结束会截断最后一段 */
+  s_in_txn = 0;
+}
+
+HAL_StatusTypeDef OLED_Bus_Write(uint8_t data, const uint8_t* p, uint16_t n){
+  if (s_dma_pending){ s_st.errors++; return HAL_BUSY; }
+  bus_bytes(data, p, n);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef OLED_Bus_WriteDMA(uint8_t data, const uint8_t* p, uint16_t n){
+  if (!s_dma_enabled) return HAL_ERROR;
+  if (s_dma_pending) return HAL_BUSY;
+  s_dma_src = p; s_dma_len = n; s_dma_data = data;
+  s_dma_pending = 1;
+  s_st.dma_starts++;
+  return HAL_OK;
+}
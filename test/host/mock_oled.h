@@ -0,0 +1,42 @@
+/* 主机测试用的 OLED 传输层（实现 oled_bus.h）与面板模拟：
+ * 把 ssd1306.c 发出的命令/显存字节按 SSD1306_CTRL 选定的控制器解释，写进一块模拟 GDDRAM，
+ * 测试读回的就是“屏上真正显示的内容”，而不只是帧缓冲。
+ *
+ * DMA 按最坏情况模拟：OLED_Bus_WriteDMA 只记下源地址和长度，真正去读源缓冲是在
+ * MockOled_DmaComplete() 时（相当于 DMA 在整个传输期间一直在读内存）。发送途中源缓冲被改了，
+ * 屏上就会出现改过的内容——防撕裂测试靠的就是这一点。 */
+#ifndef MOCK_OLED_H
+#define MOCK_OLED_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+  uint32_t bytes;          /* 收到的总字节数（命令+显存） */
+  uint32_t cmd_bytes;
+  uint32_t data_bytes;
+  uint32_t dma_starts;     /* 成功启动的 DMA 段数 */
+  uint32_t txns;           /* Begin/End 对数 */
+  uint32_t last_data_seq;  /* 最后一个显存字节的序号（按收到顺序从 1 数） */
+  uint32_t start_seq;      /* 最后一条起始行命令（0x40|n）的序号 */
+  uint32_t errors;         /* 协议错误：Begin/End 之外收到字节、DMA 未完成时又发等 */
+} MockOled_Stats_t;
+
+void    MockOled_Reset(void);                  /* 清模拟 GDDRAM（填 0xA5，模拟上电未知内容）与统计 */
+void    MockOled_SetAutoDma(uint8_t on);       /* 1=读节拍时自动完成 DMA（默认）；0=由测试逐段调 DmaComplete */
+void    MockOled_SetDmaEnabled(uint8_t on);    /* 0=WriteDMA 一律返回 HAL_ERROR（走阻塞退路） */
+uint8_t MockOled_DmaPending(void);
+void    MockOled_DmaComplete(void);            /* 完成当前一段：此刻才读源缓冲，然后调 SSD1306_BusTxDone */
+void    MockOled_DmaFail(void);                /* 当前一段出错：丢弃，调 SSD1306_BusError */
+
+void    MockOled_GetFrame(uint8_t fb[1024]);   /* 可见的 128 列 GDDRAM（页格式） */
+uint8_t MockOled_StartLine(void);              /* 面板当前的显示起始行 */
+const MockOled_Stats_t* MockOled_GetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
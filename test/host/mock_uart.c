@@ -0,0 +1,45 @@
+#include "mock_uart.h"
+#include "usart.h"
+#include <string.h>
+
+UART_HandleTypeDef huart1 = { .Init = { .BaudRate = 9600 }, .gState = HAL_UART_STATE_READY };
+
+static uint8_t  s_rx[1 << 16];
+static uint32_t s_rx_head, s_rx_tail;
+static char     s_tx[1 << 16];
+static uint32_t s_tx_len;
+
+void MockUart_Reset(void){ s_rx_head = s_rx_tail = 0; MockUart_TxClear(); }
+
+void MockUart_Feed(const void* p, uint32_t n){
+  const uint8_t* b = p;
+  while (n--){ s_rx[s_rx_head & (sizeof(s_rx) - 1)] = *b++; s_rx_head++; }
+}
+
+void MockUart_FeedStr(const char* s){ MockUart_Feed(s, (uint32_t)strlen(s)); }
+
+const char* MockUart_Tx(void){ return s_tx; }
+uint32_t    MockUart_TxLen(void){ return s_tx_len; }
+void        MockUart_TxClear(void){ s_tx_len = 0; s_tx[0] = 0; }
+
+void     UART1_RxStart(void){}
+uint16_t UART1_RxAvailable(void){ uint32_t n = s_rx_head - s_rx_tail; return (uint16_t)(n > 0xFFFF ? 0xFFFF : n); }
+int      UART1_RxGetc(void){
+  if (s_rx_tail == s_rx_head) return -1;
+  return s_rx[s_rx_tail++ & (sizeof(s_rx) - 1)];
+}
+
+static void tx_append(const uint8_t* p, uint16_t n){
+  if (n > sizeof(s_tx) - 1 - s_tx_len) n = (uint16_t)(sizeof(s_tx) - 1 - s_tx_len);
+  memcpy(&s_tx[s_tx_len], p, n);
+  s_tx_len += n;
+  s_tx[s_tx_len] = 0;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* h, const uint8_t* p, uint16_t n, uint32_t tout){
+  (void)h; (void)tout; tx_append(p, n); return HAL_OK;
+}
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef* h, const uint8_t* p, uint16_t n){
+  (void)h; tx_append(p, n); return HAL_OK;
+}
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef* h){ (void)h; return HAL_OK; }
@@ -0,0 +1,22 @@
+/* 模拟 USART1：接收端是测试喂进去的字节（代替循环 DMA 环形缓冲），
+ * 发送端 HAL_UART_Transmit_IT 立即“发完”，内容记下来供检查。nb_iot.c 对着它编译。 */
+#ifndef MOCK_UART_H
+#define MOCK_UART_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void MockUart_Reset(void);                          /* 清空收发 */
+void MockUart_Feed(const void* p, uint32_t n);      /* 模组发来的字节 */
+void MockUart_FeedStr(const char* s);
+const char* MockUart_Tx(void);                      /* 到目前为止发出去的全部内容（以 0 结尾） */
+uint32_t    MockUart_TxLen(void);
+void        MockUart_TxClear(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,121 @@
+/* 主机（Linux/gcc）编译用的 HAL 替身：只给出固件源码用到的类型、宏和函数声明，
+ * 外设函数的实现在 host_hal.c（时钟/延时）、mock_oled.c（OLED 传输层）和各测试自己的桩里。
+ * 测试的 include 路径把 test/host 排在 Core/Inc 前面，固件头文件里的 #include "stm32f1xx_hal.h" 就落到这里。 */
+#ifndef __STM32F1xx_HAL_H
+#define __STM32F1xx_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum { HAL_OK = 0, HAL_ERROR, HAL_BUSY, HAL_TIMEOUT } HAL_StatusTypeDef;
+#define HAL_MAX_DELAY 0xFFFFFFFFu
+#define UNUSED(x) ((void)(x))
+
+/* ---- 时钟、延时与周期计数 ---- */
+extern uint32_t SystemCoreClock;
+uint32_t HAL_GetTick(void);
+void     HAL_Delay(uint32_t ms);
+HAL_StatusTypeDef HAL_Init(void);
+void     SystemCoreClockUpdate(void);
+uint32_t HAL_RCC_GetHCLKFreq(void);
+
+/* 主机上没有 DWT：统计用的“周期数”换成单调时钟的纳秒数（截成 32 位，差值照样可用） */
+uint32_t Host_ClockNs(void);
+#define SSD1306_CYCCNT() Host_ClockNs()
+
+typedef struct { volatile uint32_t CTRL, CYCCNT; } DWT_Type;
+typedef struct { volatile uint32_t DEMCR; } CoreDebug_Type;
+extern DWT_Type       Host_DWT;
+extern CoreDebug_Type Host_CoreDebug;
+#define DWT       (&Host_DWT)
+#define CoreDebug (&Host_CoreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk          1u
+#define CoreDebug_DEMCR_TRCENA_Msk      (1u << 24)
+
+static inline void     __disable_irq(void){}
+static inline void     __enable_irq(void){}
+static inline uint32_t __get_PRIMASK(void){ return 0; }
+static inline void     __set_PRIMASK(uint32_t x){ (void)x; }
+static inline void     __NOP(void){}
+static inline void     __DMB(void){}
+
+/* ---- GPIO ---- */
+typedef enum { GPIO_PIN_RESET = 0, GPIO_PIN_SET } GPIO_PinState;
+typedef struct { uint32_t ODR, IDR; } GPIO_TypeDef;
+typedef struct { uint32_t Pin, Mode, Pull, Speed; } GPIO_InitTypeDef;
+extern GPIO_TypeDef Host_GPIOA, Host_GPIOB, Host_GPIOC;
+#define GPIOA (&Host_GPIOA)
+#define GPIOB (&Host_GPIOB)
+#define GPIOC (&Host_GPIOC)
+#define GPIO_PIN_0   0x0001u
+#define GPIO_PIN_1   0x0002u
+#define GPIO_PIN_4   0x0010u
+#define GPIO_PIN_5   0x0020u
+#define GPIO_PIN_6   0x0040u
+#define GPIO_PIN_7   0x0080u
+#define GPIO_PIN_8   0x0100u
+#define GPIO_PIN_9   0x0200u
+#define GPIO_PIN_10  0x0400u
+#define GPIO_PIN_11  0x0800u
+#define GPIO_PIN_13  0x2000u
+#define GPIO_MODE_INPUT      0u
+#define GPIO_MODE_OUTPUT_PP  1u
+#define GPIO_MODE_OUTPUT_OD  2u
+#define GPIO_MODE_AF_PP      3u
+#define GPIO_NOPULL          0u
+#define GPIO_PULLUP          1u
+#define GPIO_PULLDOWN        2u
+#define GPIO_SPEED_FREQ_LOW  0u
+#define GPIO_SPEED_FREQ_HIGH 2u
+void          HAL_GPIO_Init(GPIO_TypeDef* port, GPIO_InitTypeDef* init);
+void          HAL_GPIO_WritePin(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState s);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* port, uint16_t pin);
+void          HAL_GPIO_TogglePin(GPIO_TypeDef* port, uint16_t pin);
+#define __HAL_RCC_GPIOA_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_GPIOC_CLK_ENABLE() do{}while(0)
+
+/* ---- 外设句柄（只要类型和固件里读写的字段） ---- */
+typedef struct { void* Instance; void* Parent; } DMA_HandleTypeDef;
+typedef struct { uint32_t BaudRatePrescaler; } SPI_InitTypeDef;
+typedef struct { void* Instance; SPI_InitTypeDef Init; DMA_HandleTypeDef* hdmatx; } SPI_HandleTypeDef;
+typedef struct { void* Instance; DMA_HandleTypeDef* hdmatx; } I2C_HandleTypeDef;
+typedef struct { int dummy; } ADC_HandleTypeDef;
+typedef struct { uint32_t BaudRate; } UART_InitTypeDef;
+typedef struct { void* Instance; UART_InitTypeDef Init; DMA_HandleTypeDef* hdmarx; volatile uint32_t gState; } UART_HandleTypeDef;
+#define HAL_UART_STATE_READY 0x20u
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* h, const uint8_t* p, uint16_t n, uint32_t tout);
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef* h, const uint8_t* p, uint16_t n);
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef* h);
+
+typedef struct { uint32_t ARR, CCR[4]; } TIM_HandleTypeDef;
+#define TIM_CHANNEL_1 0x0u
+#define TIM_CHANNEL_2 0x4u
+#define __HAL_TIM_GET_AUTORELOAD(h)        ((h)->ARR)
+#define __HAL_TIM_SET_AUTORELOAD(h, v)     ((h)->ARR = (v))
+#define __HAL_TIM_SET_COMPARE(h, ch, v)    ((h)->CCR[(ch) >> 2] = (v))
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef* h, uint32_t ch);
+
+/* ---- 时钟树（main.c 的 SystemClock_Config 用） ---- */
+typedef struct { uint32_t PLLState, PLLSource, PLLMUL; } RCC_PLLInitTypeDef;
+typedef struct { uint32_t OscillatorType, HSEState, HSIState; RCC_PLLInitTypeDef PLL; } RCC_OscInitTypeDef;
+typedef struct { uint32_t ClockType, SYSCLKSource, AHBCLKDivider, APB1CLKDivider, APB2CLKDivider; } RCC_ClkInitTypeDef;
+enum {
+  RCC_OSCILLATORTYPE_HSE = 1, RCC_HSE_ON, RCC_HSI_ON, RCC_PLL_ON, RCC_PLLSOURCE_HSE, RCC_PLL_MUL9,
+  RCC_SYSCLKSOURCE_PLLCLK, RCC_SYSCLK_DIV1, RCC_HCLK_DIV1, RCC_HCLK_DIV2, FLASH_LATENCY_2
+};
+#define RCC_CLOCKTYPE_SYSCLK 0x1u
+#define RCC_CLOCKTYPE_HCLK   0x2u
+#define RCC_CLOCKTYPE_PCLK1  0x4u
+#define RCC_CLOCKTYPE_PCLK2  0x8u
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef* init);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef* init, uint32_t latency);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
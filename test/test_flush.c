@@ -0,0 +1,130 @@
+/* DMA 双缓冲刷新的防撕裂测试：模拟面板的 DMA 到“发完”那一刻才读源缓冲，
+ * 刷新途中应用照常往绘图缓冲里画、改起始行，屏上最终必须正好是 UpdateAsync 那一刻的画面，
+ * 起始行命令必须排在这一帧全部显存之后，而途中改的起始行留到下一帧。 */
+#include "ssd1306.h"
+#include "host_test.h"
+#include "mock_oled.h"
+#include <stdlib.h>
+#include <string.h>
+
+static uint8_t s_flushed;
+static void on_flush(void){ s_flushed++; }
+
+static void panel(uint8_t fb[1024]){ MockOled_GetFrame(fb); }
+
+/* 随手乱画：整屏填充、字、矩形、线都有，覆盖多页 */
+static void scribble(unsigned seed){
+  char s[12];
+  switch (seed % 4){
+    case 0: SSD1306_Fill(seed & 1); break;
+    case 1: snprintf(s, sizeof(s), "%u", seed); SSD1306_DrawString((int)(seed % 100), (int)(seed % 57), s); break;
+    case 2: SSD1306_FillRect((int)(seed % 90), (int)(seed % 50), 37, 13, (uint8_t)(seed & 1)); break;
+    default: SSD1306_DrawLine(0, (int)(seed % 64), 127, (int)((seed * 7) % 64), 1); break;
+  }
+}
+
+/* 启动一帧异步刷新，途中每完成一段 DMA 就往绘图缓冲乱画一次，必要时中途改起始行 */
+static void flush_while_drawing(unsigned seed, int change_start){
+  uint8_t want[1024], front[1024], fb[1024];
+  memcpy(want, SSD1306_GetBuffer(), sizeof(want));
+  uint8_t want_start = SSD1306_GetStartLine();
+
+  SSD1306_UpdateAsync();
+  memcpy(front, SSD1306_GetFrontBuffer(), sizeof(front));
+  CHECK(!memcmp(front, want, sizeof(want)));             /* 前台缓冲 = 交出去那一刻的画面 */
+
+  unsigned steps = 0;
+  while (SSD1306_IsBusy()){
+    CHECK(MockOled_DmaPending());
+    scribble(seed + steps);
+    if (change_start && steps == 1) SSD1306_SetStartLine((uint8_t)(want_start + 16));
+    CHECK(!memcmp(SSD1306_GetFrontBuffer(), front, sizeof(front)));   /* 发送途中前台不许变 */
+    MockOled_DmaComplete();
+    if (++steps > 64) break;
+  }
+  CHECK(!SSD1306_IsBusy());
+
+  panel(fb);
+  CHECK(!memcmp(fb, want, sizeof(fb)));                  /* 屏上正好是交出去的那一帧 */
+  CHECK_EQ(MockOled_StartLine(), want_start);            /* 途中改的起始行不属于这一帧 */
+}
+
+int main(void){
+  uint8_t fb[1024];
+  const MockOled_Stats_t* st = MockOled_GetStats();
+
+  MockOled_Reset();
+  SSD1306_Init();
+  SSD1306_SetFlushCallback(on_flush);
+  panel(fb);
+  CHECK(!memcmp(fb, SSD1306_GetBuffer(), sizeof(fb)));   /* 上电后整屏重发（面板初值 0xA5） */
+
+  /* 1. 基本情形：多页画面 + 新起始行，逐段完成 DMA，途中乱画并再改一次起始行 */
+  MockOled_SetAutoDma(0);
+  SSD1306_Fill(0);
+  SSD1306_DrawString(0, 0, "Frame B top");
+  SSD1306_FillRect(10, 20, 50, 30, 1);
+  SSD1306_DrawString(30, 57, "bottom");
+  SSD1306_SetStartLine(8);
+  s_flushed = 0;
+  flush_while_drawing(1, 1);
+  CHECK_EQ(s_flushed, 1);
+  CHECK(st->dma_starts > 2);                             /* 确实分了多段 DMA */
+  CHECK(st->start_seq > st->last_data_seq);              /* 起始行命令在全部显存之后 */
+
+  /* 下一帧才带上途中改的起始行，同样在显存之后 */
+  uint32_t data_before = st->last_data_seq;
+  flush_while_drawing(2, 0);
+  CHECK_EQ(MockOled_StartLine(), 24);
+  CHECK(st->last_data_seq > data_before);
+  CHECK(st->start_seq > st->last_data_seq);
+
+  /* 2. 只改起始行：不发显存，只发 1 字节命令（先把途中画的内容刷掉） */
+  MockOled_SetAutoDma(1);
+  SSD1306_Update();
+  MockOled_SetAutoDma(0);
+  uint32_t d0 = st->data_bytes, c0 = st->cmd_bytes;
+  SSD1306_SetStartLine(40);
+  flush_while_drawing(3, 0);
+  CHECK_EQ(MockOled_StartLine(), 40);
+  CHECK_EQ(st->data_bytes, d0);
+  CHECK_EQ(st->cmd_bytes - c0, 1);
+
+  /* 3. 随机压力：每帧随机画、随机起始行，途中乱画；屏上每帧都必须是完整的那一帧 */
+  srand(12345);
+  for (int f = 0; f < 300; ++f){
+    for (int k = rand() % 4; k >= 0; --k) scribble((unsigned)rand());
+    if (rand() % 3 == 0) SSD1306_SetStartLine((uint8_t)(rand() % 64));
+    flush_while_drawing((unsigned)rand(), rand() % 5 == 0);
+    if (Host_FailCount){ fprintf(stderr, "第 %d 帧出错\n", f); break; }
+  }
+
+  /* 4. 发送中途出错：本帧作废，下一帧整屏重发并补发起始行 */
+  SSD1306_Fill(0);
+  SSD1306_DrawString(0, 32, "after error");
+  SSD1306_SetStartLine(0);
+  SSD1306_UpdateAsync();
+  MockOled_DmaComplete();
+  MockOled_DmaFail();
+  CHECK(!SSD1306_IsBusy());
+  MockOled_SetAutoDma(1);
+  d0 = st->data_bytes;
+  SSD1306_Update();
+  CHECK_EQ(st->data_bytes - d0, 1024);
+  panel(fb);
+  CHECK(!memcmp(fb, SSD1306_GetBuffer(), sizeof(fb)));
+  CHECK_EQ(MockOled_StartLine(), 0);
+
+  /* 5. DMA 起不来：退回阻塞发送，画面照样正确 */
+  MockOled_SetDmaEnabled(0);
+  SSD1306_DrawString(0, 8, "no dma");
+  SSD1306_SetStartLine(8);
+  SSD1306_Update();
+  panel(fb);
+  CHECK(!memcmp(fb, SSD1306_GetBuffer(), sizeof(fb)));
+  CHECK_EQ(MockOled_StartLine(), 8);
+  CHECK(st->start_seq > st->last_data_seq);
+
+  CHECK_EQ(st->errors, 0);
+  return Host_Failures() != 0;
+}
@@ -0,0 +1,314 @@
+/* NB 模组回复的解析：NB_SplitFields / NB_ParseInt 的边界情形与随机输入，
+ * 以及经 NB_Poll 收行、按前缀表分发 URC 的整条路径（真实 nb_iot.c，串口换成 host/mock_uart.c）。
+ * 最后给出每行/每次调用的主机耗时，作为改动前后对比的基准。 */
+#include "nb_iot.h"
+#include "host_test.h"
+#include "mock_uart.h"
+#include <stdlib.h>
+#include <string.h>
+
+static char s_recv_buf[512];
+static int  s_recv_cnt;
+static void on_recv(const char* data, int len){
+  CHECK_EQ((int)strlen(data), len);
+  snprintf(s_recv_buf, sizeof(s_recv_buf), "%s", data);
+  s_recv_cnt++;
+}
+
+static void poll_line(const char* line){
+  MockUart_FeedStr(line);
+  MockUart_FeedStr("\r\n");
+  NB_Poll();
+}
+
+/* ---------------- NB_SplitFields ---------------- */
+static int split(const char* in, int max, char* f[], char buf[256]){
+  snprintf(buf, 256, "%s", in);
+  return NB_SplitFields(buf, f, max);
+}
+
+static void expect_fields(const char* in, int max, int n_want, const char* const want[]){
+  char buf[256];
+  char* f[16];
+  int n = split(in, max, f, buf);
+  if (n != n_want){ fprintf(stderr, "[%s] 字段数 %d，期望 %d\n", in, n, n_want); Host_FailCount++; return; }
+  for (int i = 0; i < n; ++i)
+    if (strcmp(f[i], want[i])){ fprintf(stderr, "[%s] 第 %d 个字段 \"%s\"，期望 \"%s\"\n", in, i, f[i], want[i]); Host_FailCount++; }
+}
+#define FIELDS(in, max, ...) do{ static const char* const w_[] = { __VA_ARGS__ }; \
+    expect_fields(in, max, (int)(sizeof(w_) / sizeof(w_[0])), w_); }while(0)
+
+static void split_cases(void){
+  FIELDS("1,2,3", 6, "1", "2", "3");
+  FIELDS(" 5, 6", 6, "5", "6");                                   /* 前导空格 */
+  FIELDS("\"recv\",1,4,\"a,b\"", 6, "recv", "1", "4", "a,b");     /* 引号里的逗号不切 */
+  FIELDS("\"a,b", 6, "a,b");                                      /* 没有收尾引号：到行尾 */
+  FIELDS("\"ab\"x,2", 6, "ab", "2");                              /* 收尾引号后的杂字丢掉 */
+  FIELDS("\"\",\"\"", 6, "", "");
+  FIELDS(",,", 6, "", "", "");                                    /* 空字段 */
+  FIELDS("1,", 6, "1", "");
+  FIELDS("", 6, "");
+  FIELDS("1,2,3,4", 2, "1", "2");                                 /* 到上限：剩下的不要 */
+  FIELDS("\"x,y\",2,3", 1, "x,y");
+  FIELDS("a\"b,c", 6, "a\"b", "c");                               /* 不在开头的引号照原样 */
+
+  char* f[2];
+  char buf[8] = "1,2";
+  CHECK_EQ(NB_SplitFields(buf, f, 0), 0);
+  CHECK_EQ(NB_SplitFields(NULL, f, 2), 0);
+}
+
+/* 对照实现：按文档语义逐字符拷出字段 */
+static int ref_split(const char* in, char out[][80], int max){
+  int n = 0;
+  size_t i = 0, L = strlen(in);
+  for (;;){
+    size_t k = 0;
+    while (in[i] == ' ') i++;
+    if (in[i] == '"'){
+      for (i++; i < L && in[i] != '"'; ) out[n][k++] = in[i++];
+      if (i < L) i++;
+      while (i < L && in[i] != ',') i++;
+    } else {
+      while (i < L && in[i] != ',') out[n][k++] = in[i++];
+    }
+    out[n++][k] = 0;
+    if (i >= L || n == max) break;
+    i++;
+  }
+  return n;
+}
+
+static uint32_t s_rng = 1;
+static unsigned rnd(unsigned n){ s_rng = s_rng * 1103515245u + 12345u; return (s_rng >> 8) % n; }
+
+static void split_fuzz(void){
+  static const char ALPHA[] = ",,,\"\"  a1-";
+  for (int it = 0; it < 200000; ++it){
+    char in[72], buf[80], want[16][80];
+    char* f[16];
+    int len = (int)rnd(70), max = 1 + (int)rnd(8);
+    for (int i = 0; i < len; ++i) in[i] = ALPHA[rnd(sizeof(ALPHA) - 1)];
+    in[len] = 0;
+    memset(buf, 0xCC, sizeof(buf));
+    memcpy(buf, in, (size_t)len + 1);
+
+    int n = NB_SplitFields(buf, f, max), nw = ref_split(in, want, max);
+    int bad = (n != nw || n < 1 || n > max);
+    for (int i = 0; !bad && i < n; ++i){
+      bad |= (f[i] < buf || f[i] > buf + len);                      /* 字段指针在原串里 */
+      bad |= strcmp(f[i], want[i]) != 0;
+      if (i) bad |= (f[i] <= f[i - 1]);
+    }
+    for (int i = len + 1; i < (int)sizeof(buf); ++i) bad |= ((uint8_t)buf[i] != 0xCC);   /* 没写出界 */
+    if (bad){ fprintf(stderr, "SplitFields 随机输入不符：[%s] max=%d\n", in, max); Host_FailCount++; return; }
+  }
+}
+
+/* ---------------- NB_ParseInt ---------------- */
+static void expect_int(const char* s, int ok, int32_t want, int rest){
+  int32_t v = 12345;
+  const char* e = NB_ParseInt(s, &v);
+  if (!ok){
+    if (e){ fprintf(stderr, "ParseInt(\"%s\") 应失败\n", s); Host_FailCount++; }
+    return;
+  }
+  if (!e || v != want || (e - s) != rest){
+    fprintf(stderr, "ParseInt(\"%s\") = %ld @%d，期望 %ld @%d\n", s, (long)v, e ? (int)(e - s) : -1, (long)want, rest);
+    Host_FailCount++;
+  }
+}
+
+static void parse_cases(void){
+  expect_int("0", 1, 0, 1);
+  expect_int("-0", 1, 0, 2);
+  expect_int("+7", 1, 7, 2);
+  expect_int("  42x", 1, 42, 4);
+  expect_int(" -12,3", 1, -12, 4);
+  expect_int("99", 1, 99, 2);
+  expect_int("2147483639", 1, 2147483639, 10);
+  expect_int("2147483640", 1, 2147483640, 10);                   /* 饱和点附近不能提前饱和 */
+  expect_int("2147483646", 1, 2147483646, 10);
+  expect_int("2147483647", 1, INT32_MAX, 10);
+  expect_int("2147483648", 1, INT32_MAX, 10);                    /* 溢出饱和 */
+  expect_int("99999999999999999999", 1, INT32_MAX, 20);
+  expect_int("-2147483647", 1, -INT32_MAX, 11);
+  expect_int("-99999999999", 1, -INT32_MAX, 12);
+  expect_int("", 0, 0, 0);
+  expect_int("-", 0, 0, 0);
+  expect_int("+-1", 0, 0, 0);
+  expect_int(" x1", 0, 0, 0);
+  expect_int("\"5\"", 0, 0, 0);
+  CHECK(NB_ParseInt(NULL, NULL) == NULL);
+  CHECK(NB_ParseInt("8", NULL) != NULL);
+}
+
+static void parse_fuzz(void){
+  static const char ALPHA[] = "0123456789012345678901234567890123456789 +-x";
+  for (int it = 0; it < 200000; ++it){
+    char s[40];
+    int len = (int)rnd(30);
+    for (int i = 0; i < len; ++i) s[i] = ALPHA[rnd(sizeof(ALPHA) - 1)];
+    s[len] = 0;
+
+    /* 对照：strtoll 的语义加饱和 */
+    const char* p = s;
+    while (*p == ' ') p++;
+    int neg = 0;
+    if (*p == '-' || *p == '+') neg = (*p++ == '-');
+    int ok = (*p >= '0' && *p <= '9');
+    long long x = 0;
+    const char* q = p;
+    for (; *q >= '0' && *q <= '9'; ++q) x = (x > INT32_MAX) ? x : x * 10 + (*q - '0');
+    if (x > INT32_MAX) x = INT32_MAX;
+
+    int32_t v = 0;
+    const char* e = NB_ParseInt(s, &v);
+    if (ok != (e != NULL) || (ok && (e != q || v != (int32_t)(neg ? -x : x)))){
+      fprintf(stderr, "ParseInt 随机输入不符：\"%s\"\n", s);
+      Host_FailCount++;
+      return;
+    }
+  }
+}
+
+/* ---------------- URC 分发（经 NB_Poll） ---------------- */
+static void urc_cases(void){
+  NB_SetRecvHook(on_recv);
+  memset(&g_nb, 0, sizeof(g_nb));
+
+  poll_line("+CEREG: 5");                           CHECK_EQ(g_nb.reg, 5);
+  poll_line("+CEREG: 1,2");                         CHECK_EQ(g_nb.reg, 2);   /* AT+CEREG? 的回复取第 2 个 */
+  poll_line("+CEREG: 1,\"1A2B\",\"0123ABCD\",9");   CHECK_EQ(g_nb.reg, 1);   /* 带位置信息的上报取第 1 个 */
+  poll_line("+CSQ: 23,99");                         CHECK_EQ(g_nb.csq, 23);
+  poll_line("+CSQ:7,99");                           CHECK_EQ(g_nb.csq, 7);
+  poll_line("+QIOPEN: 0,0");                        CHECK_EQ(g_nb.opened, 0);  /* 不是 socket 1 */
+  poll_line("+QIOPEN: 1,0");                        CHECK_EQ(g_nb.opened, 1);
+  poll_line("+QIURC: \"closed\",1");                CHECK_EQ(g_nb.opened, 0);
+
+  /* 直推数据：引号里的逗号属于数据 */
+  s_recv_cnt = 0;
+  poll_line("+QIURC: \"recv\",1,9,\"SNAP,K,1\"");
+  CHECK_EQ(s_recv_cnt, 1);
+  CHECK(!strcmp(s_recv_buf, "SNAP,K,1"));
+  poll_line("+QIURC: \"recv\",2,3,\"abc\"");          /* 别的 socket 不管 */
+  CHECK_EQ(s_recv_cnt, 1);
+
+  /* +QIRD: <长度> 之后的一行是数据，长度 0 则不是 */
+  poll_line("+QIRD: 4");
+  poll_line("+CSQ: 1,1");                           /* 这一行是数据，不能当 URC */
+  CHECK_EQ(s_recv_cnt, 2);
+  CHECK(!strcmp(s_recv_buf, "+CSQ: 1,1"));
+  CHECK_EQ(g_nb.csq, 7);
+  poll_line("+QIRD: 0");
+  poll_line("+CSQ: 9,99");
+  CHECK_EQ(g_nb.csq, 9);
+  CHECK_EQ(s_recv_cnt, 2);
+
+  /* 缓存模式的 recv：排一条 AT+QIRD 去读 */
+  MockUart_TxClear();
+  poll_line("+QIURC: \"recv\",1");
+  CHECK_EQ(NB_AtPending(), 1);
+  CHECK(strstr(MockUart_Tx(), "AT+QIRD=1,512\r\n") != NULL);
+  poll_line("OK");
+  CHECK_EQ(NB_AtPending(), 0);
+
+  /* 不认识的前缀、缺冒号、前缀只差一点的：一律不动 g_nb */
+  NB_State_t before = g_nb;
+  static const char* const UNKNOWN[] = {
+    "+CSQX: 5,5", "+CS: 5", "+CSQ 5,5", "+QI: 1,0", "+QIURCX: \"closed\",1", "+: 3", "+ZZZ: 1",
+    "CSQ: 3", "+CEREGS: 4", "+CERE: 4", "+", "+QIOPEN", "OK", "ERROR", ">",
+  };
+  for (size_t i = 0; i < sizeof(UNKNOWN) / sizeof(UNKNOWN[0]); ++i){
+    poll_line(UNKNOWN[i]);
+    if (memcmp(&before, &g_nb, sizeof(g_nb))){ fprintf(stderr, "未知行 \"%s\" 改了 g_nb\n", UNKNOWN[i]); Host_FailCount++; g_nb = before; }
+  }
+
+  /* 空字段：解析不出数字就不改 */
+  poll_line("+CSQ: ,99");                           CHECK_EQ(g_nb.csq, 9);
+  poll_line("+CEREG: ");                            CHECK_EQ(g_nb.reg, 1);
+
+  /* 半行分两次到：拼起来再解析 */
+  MockUart_FeedStr("+CSQ: 2");
+  NB_Poll();
+  CHECK_EQ(g_nb.csq, 9);
+  MockUart_FeedStr("1,99\r\n");
+  NB_Poll();
+  CHECK_EQ(g_nb.csq, 21);
+
+  /* 超长行截断，不越界，下一行照常 */
+  char longl[400];
+  memset(longl, '7', sizeof(longl));
+  memcpy(longl, "+CSQ: 17,", 9);
+  longl[sizeof(longl) - 1] = 0;
+  poll_line(longl);
+  CHECK_EQ(g_nb.csq, 17);
+  poll_line("+CEREG: 5");
+  CHECK_EQ(g_nb.reg, 5);
+}
+
+static void urc_fuzz(void){
+  static const char* const PREFIX[] = {
+    "+CEREG", "+CSQ", "+QIOPEN", "+QIRD", "+QIURC",                  /* 表里有的（须在前 5 个） */
+    "+CSQX", "+CS", "+QI", "+QIURCX", "+", "+ZZZ", "CSQ", "", "+CEREGX", "+A",
+  };
+  static const char ALPHA[] = ",,,\"\"  019-recvclosed";
+  for (int it = 0; it < 100000; ++it){
+    char line[200];
+    unsigned k = rnd(sizeof(PREFIX) / sizeof(PREFIX[0]));
+    int n = snprintf(line, sizeof(line), "%s%s", PREFIX[k], rnd(8) ? ": " : "");
+    int len = (int)rnd(60);
+    for (int i = 0; i < len; ++i) line[n++] = ALPHA[rnd(sizeof(ALPHA) - 1)];
+    line[n] = 0;
+
+    NB_State_t before = g_nb;
+    poll_line(line);
+    if (k >= 5 && memcmp(&before, &g_nb, sizeof(g_nb))){
+      fprintf(stderr, "随机未知行 \"%s\" 改了 g_nb\n", line);
+      Host_FailCount++;
+      return;
+    }
+    if (NB_AtPending()) poll_line("OK");             /* 缓存模式 recv 排的 AT+QIRD 答掉，队列别堆满 */
+  }
+}
+
+/* ---------------- 基准 ---------------- */
+static volatile int32_t s_sink;
+static const char URC_RECV[] = "\"recv\",1,24,\"VDD=3301,T=25C,H=61%\"";
+
+static void b_split(void* a){ (void)a; char buf[64]; char* f[6]; memcpy(buf, URC_RECV, sizeof(URC_RECV)); s_sink = NB_SplitFields(buf, f, 6); }
+static void b_parse(void* a){ (void)a; int32_t v, w; NB_ParseInt("23", &v); NB_ParseInt("2147483647", &w); s_sink = v ^ w; }
+static void b_sscanf(void* a){ (void)a; int v, w; sscanf("23", "%d", &v); sscanf("2147483647", "%d", &w); s_sink = v ^ w; }
+
+static const char* const TRAFFIC[] = {
+  "+CEREG: 1", "+CSQ: 23,99", "+QIURC: \"recv\",1,24,\"VDD=3301,T=25C,H=61%\"", "OK",
+  "+CEREG: 1,\"1A2B\",\"0123ABCD\",9", "SEND OK", "+QIOPEN: 1,0", "+CSQX: 1",
+};
+#define N_TRAFFIC (sizeof(TRAFFIC) / sizeof(TRAFFIC[0]))
+static void b_poll(void* a){
+  (void)a;
+  for (size_t i = 0; i < N_TRAFFIC; ++i){ MockUart_FeedStr(TRAFFIC[i]); MockUart_FeedStr("\r\n"); }
+  NB_Poll();
+}
+
+int main(void){
+  MockUart_Reset();
+
+  split_cases();
+  split_fuzz();
+  parse_cases();
+  parse_fuzz();
+  urc_cases();
+  urc_fuzz();
+
+  NB_SetRecvHook(on_recv);
+  double ns_split = Host_BenchNs(b_split, NULL, 200000);
+  double ns_parse = Host_BenchNs(b_parse, NULL, 200000) / 2;
+  double ns_scanf = Host_BenchNs(b_sscanf, NULL, 200000) / 2;
+  double ns_poll  = Host_BenchNs(b_poll, NULL, 50000) / N_TRAFFIC;
+  printf("%10.1f  NB_SplitFields（+QIURC recv，4 字段）\n", ns_split);
+  printf("%10.1f  NB_ParseInt / 次（sscanf %%d 为 %.1f）\n", ns_parse, ns_scanf);
+  printf("%10.1f  NB_Poll 收行 + 分发 / 行（典型上报混合）\n", ns_poll);
+
+  return Host_Failures() != 0;
+}
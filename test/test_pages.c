@@ -0,0 +1,183 @@
+/* 页面金样测试：用 main.c 里真实的控件与页面定义，把每一页渲染出来、经模拟面板刷新，
+ * 与 test/golden/ 下的 PBM 逐点比对；同时检查增量渲染（UI_Render 只画脏控件、刷新只发变化窗口）
+ * 得到的画面与整页重画完全一致。改了绘图代码后画面确实该变时，用 UPDATE_GOLDEN=1 重跑来更新金样。 */
+#define main fw_main
+#include "../Core/Src/main.c"
+#undef main
+
+#include "host_test.h"
+#include "mock_oled.h"
+
+/* 刷新到模拟面板，屏上内容必须与帧缓冲一致；返回面板画面 */
+static void flush(uint8_t fb[1024]){
+  SSD1306_Update();
+  MockOled_GetFrame(fb);
+  CHECK(!memcmp(fb, SSD1306_GetBuffer(), 1024));
+  CHECK(!memcmp(fb, SSD1306_GetFrontBuffer(), 1024));
+  CHECK_EQ(MockOled_StartLine(), SSD1306_GetStartLine());
+}
+
+static void shot(const char* name){
+  uint8_t fb[1024];
+  flush(fb);
+  Host_CheckGolden(name, fb, MockOled_StartLine());
+}
+
+static void show(const UI_Page_t* pg, const char* name){
+  if (Console_IsShown()) Console_Hide();
+  UI_Show(pg);
+  shot(name);
+}
+
+/* 增量路径：在已显示的页上改值、UI_Render，结果必须与整页重画逐字节相同 */
+static void check_incremental(const UI_Page_t* pg, const char* what){
+  uint8_t inc[1024], full[1024];
+  UI_Render(pg);
+  flush(inc);
+  UI_Show(pg);
+  flush(full);
+  if (memcmp(inc, full, sizeof(inc))){
+    fprintf(stderr, "%s：增量渲染与整页重画不一致\n", what);
+    Host_FailCount++;
+  }
+}
+
+/* 子区域里居中的预编译字符串：只在控件自己的 x/w 内居中，不是整屏居中 */
+static UI_Widget_t w_half_l = UI_LABEL_ID(0,  24, 64, UI_ALIGN_CENTER, UI_STR_WELCOME);
+static UI_Widget_t w_half_r = UI_LABEL_ID(64, 24, 64, UI_ALIGN_CENTER, UI_STR_TEMP_HUMI_CN);
+static UI_Widget_t* const HALVES[] = { &w_half_l, &w_half_r };
+static const UI_Page_t PAGE_HALVES = UI_PAGE(HALVES);
+
+static void check_centered_in_rect(void){
+  uint8_t want[1024];
+  SSD1306_Fill(0);
+  OLED_DrawText(0 + (64 - OLED_TextWidth(UI_STR_WELCOME)) / 2, 24, UI_STR_WELCOME);
+  OLED_DrawText(64 + (64 - OLED_TextWidth(UI_STR_TEMP_HUMI_CN)) / 2, 24, UI_STR_TEMP_HUMI_CN);
+  memcpy(want, SSD1306_GetBuffer(), sizeof(want));
+  UI_Show(&PAGE_HALVES);
+  if (memcmp(want, SSD1306_GetBuffer(), sizeof(want))){
+    fprintf(stderr, "UI_ALIGN_CENTER 的字符串控件没有在自身区域内居中\n");
+    Host_FailCount++;
+  }
+}
+
+/* 趋势曲线的样本：确定的起伏，不依赖浮点 */
+static int16_t wave(int i, int base, int amp){
+  static const int8_t tri[16] = { 0, 2, 4, 6, 8, 6, 4, 2, 0, -2, -4, -6, -8, -6, -4, -2 };
+  return (int16_t)(base + tri[i & 15] * amp / 8 + (i / 16) % 3);
+}
+
+int main(void){
+  MockOled_Reset();
+  SSD1306_Init();
+
+  /* 开机画面：欢迎页、自检结果页 */
+  draw_welcome();
+  shot("welcome");
+  SelfTestResult st = { .oled_visual = 1, .bh_found = 1, .bh_read_ok = 1, .dht_ok = 0, .vdd_mv = 3301 };
+  draw_hw_check(&st);
+  shot("hw_check");
+  /* 放大版 1×1 不加粗时必须与 OLED_DrawText_Centered 逐字节相同（含汉字） */
+  {
+    uint8_t a[1024];
+    SSD1306_Fill(0);
+    OLED_DrawText_Centered(20, UI_STR_TEMP_HUMI_CN);
+    memcpy(a, SSD1306_GetBuffer(), sizeof(a));
+    SSD1306_Fill(0);
+    OLED_DrawText_CenteredScaled(20, UI_STR_TEMP_HUMI_CN, 1, 1, 0);
+    CHECK(!memcmp(a, SSD1306_GetBuffer(), sizeof(a)));
+  }
+  /* 汉字左边伸出屏外：可见部分与画在 x=0 时右移出来的那几列相同。
+   * 汉字上提 4px，y=4/7 落在第 0 页（对齐与不对齐各一次），裁剪时最容易算出缓冲区之前的地址 */
+  for (int y = 4; y <= 7; y += 3){
+    uint8_t a[1024];
+    SSD1306_Fill(0);
+    OLED_DrawText(0, y, UI_STR_TEMP_HUMI_CN);
+    memcpy(a, SSD1306_GetBuffer(), sizeof(a));
+    SSD1306_Fill(0);
+    OLED_DrawText(-5, y, UI_STR_TEMP_HUMI_CN);
+    const uint8_t* b = SSD1306_GetBuffer();
+    for (int p = 0; p < 8; ++p)
+      for (int c = 0; c < 27; ++c) CHECK_EQ(b[p * 128 + c], a[p * 128 + c + 5]);
+  }
+
+  check_centered_in_rect();
+
+  /* 顶栏：告警喇叭、风扇第 1 帧、手动指示都亮，三个图标都进金样 */
+  UI_SetIcon(&w_speaker, 1);
+  UI_Animate(&w_fan, 1);
+  UI_SetIcon(&w_manual, 1);
+  UI_SetNumber(&w_vdd, 3301);
+
+  UI_SetNumber(&w_env_l1, 25);
+  UI_SetNumber(&w_env_l2, 61);
+  show(&UI_PAGES[PAGE_ENV], "env");
+  UI_SetNumber(&w_env_l1, 31);
+  UI_SetNumber(&w_env_l2, 47);
+  UI_SetNumber(&w_vdd, 3287);
+  UI_Animate(&w_fan, 1);
+  check_incremental(&UI_PAGES[PAGE_ENV], "ENV 改读数");
+
+  UI_SetText(&w_env_l1, "NO DHT11");
+  UI_SetText(&w_env_l2, "or wiring error");
+  show(&UI_PAGES[PAGE_ENV], "env_nodht");
+
+  UI_SetNumber(&w_lux_l1, lux_x10(123.4f));
+  UI_SetText(&w_lux_l2, "");
+  show(&UI_PAGES[PAGE_LUX], "lux");
+  UI_SetNumber(&w_lux_l1, lux_x10(18888.8f));
+  check_incremental(&UI_PAGES[PAGE_LUX], "LUX 改读数");
+
+  UI_SetText(&w_lux_l1, "BH1750 N/A");
+  UI_SetText(&w_lux_l2, "Check ADDR/I2C");
+  show(&UI_PAGES[PAGE_LUX], "lux_na");
+
+  for (int i = 0; i < 100; ++i){
+    UI_ChartPush(&w_temp_chart, wave(i, 25, 3));
+    UI_ChartPush(&w_humi_chart, wave(i + 5, 60, 12));
+    UI_ChartPush(&w_lux_chart,  wave(i + 9, 300, 200));
+  }
+  chart_caption(&w_temp_cap, "Temp", &c_temp, " C");
+  chart_caption(&w_humi_cap, "Humi", &c_humi, " %");
+  chart_caption(&w_lux_cap,  "Lux",  &c_lux,  " lx");
+  show(&UI_PAGES[PAGE_TEMP_TREND], "temp_trend");
+  show(&UI_PAGES[PAGE_HUMI_TREND], "humi_trend");
+  show(&UI_PAGES[PAGE_LUX_TREND],  "lux_trend");
+  /* 曲线写满 128 列后左移：只画新列的路径要与重画一致 */
+  for (int i = 100; i < 140; ++i){
+    UI_ChartPush(&w_lux_chart, wave(i + 9, 300, 200));
+    if (i % 7 == 0) check_incremental(&UI_PAGES[PAGE_LUX_TREND], "光照曲线追加");
+  }
+
+  UI_SetNumber(&w_nb_t, 25);
+  UI_SetNumber(&w_nb_h, 61);
+  UI_SetNumber(&w_nb_l, 12345);
+  UI_SetText(&w_nb_text, "SNAP K");
+  UI_SetNumber(&w_nb_baud, (int32_t)huart1.Init.BaudRate);
+  show(&UI_PAGES[PAGE_NB], "nb");
+  /* 读数变了只重画对应的数字控件 */
+  UI_SetNumber(&w_nb_t, 26);
+  UI_SetText(&w_nb_l, "L:--");
+  check_incremental(&UI_PAGES[PAGE_NB], "NB 读数");
+  UI_SetNumber(&w_nb_t, 25);
+  UI_SetNumber(&w_nb_l, 12345);
+  show(&UI_PAGES[PAGE_NB], "nb");
+
+  UI_SetNumber(&w_low_l2, 2980);
+  show(&UI_PAGE_LOW_VDD, "low_vdd");
+
+  /* 控制台：超过一屏后靠起始行滚动，金样按屏上看到的样子（已按起始行转回） */
+  Console_Show();
+  for (int i = 0; i < 11; ++i){
+    char l[32];
+    snprintf(l, sizeof(l), "AT+QISEND=1,%d", 10 + i * 3);
+    Console_PushTagged((i & 1) ? '<' : '>', (i & 1) ? "SEND OK" : l);
+  }
+  shot("con");
+  CHECK(MockOled_StartLine() != 0);
+  Console_PageUp();
+  shot("con_pageup");
+
+  CHECK_EQ(MockOled_GetStats()->errors, 0);
+  return Host_Failures() != 0;
+}
@@ -0,0 +1,165 @@
+/* 远程截屏的起始行：FB 行里的起始行必须是与影子缓冲那一帧一同发出的值，
+ * SetStartLine 之后还没刷新、或刷新途中又改的值都不能算进这一张（否则主机按错的行数旋转画面）。
+ * 分步发送（NB 一次只排一行）：逐行发出的内容与一次发完相同，发送途中屏幕变了不影响这一张，
+ * sink 暂时排不下时这一行留着重发，中途失败丢掉剩下的行、下一张改发关键帧。 */
+#include "ssd1306.h"
+#include "oled_snap.h"
+#include "host_test.h"
+#include "mock_oled.h"
+#include <stdlib.h>
+#include <string.h>
+
+static int s_start = -1;
+
+/* FB,<序号>,<K|D>,<块号>/<块数>,<起始行>,<CRC16>,<base64>：取起始行 */
+static int sink(const char* line){
+  int seq, idx, cnt, start;
+  char type;
+  unsigned crc;
+  CHECK_EQ(sscanf(line, "FB,%d,%c,%d/%d,%d,%4x,", &seq, &type, &idx, &cnt, &start, &crc), 6);
+  if (s_start >= 0) CHECK_EQ(start, s_start);        /* 同一张的每一块都一样 */
+  s_start = start;
+  return 0;
+}
+
+/* 分步发送收到的行（去掉 “FB,<序号>,” 便于与另一张比较） */
+#define MAX_LINES 16
+static char s_lines[MAX_LINES][300];
+static int  s_nlines;
+static int  s_full;                                  /* >0：接下来这么多次假装队列满 */
+
+static int collect(const char* line){
+  if (s_full > 0){ s_full--; return -5; }
+  const char* p = strchr(line + 3, ',');
+  CHECK(p != NULL && s_nlines < MAX_LINES);
+  if (!p || s_nlines >= MAX_LINES) return -1;
+  snprintf(s_lines[s_nlines++], sizeof(s_lines[0]), "%s", p + 1);
+  return 0;
+}
+static int fail_sink(const char* line){ (void)line; return -1; }
+
+static char snap_type(int i){ return s_lines[i][0]; }
+
+/* 噪点画面：压不动，分成很多行 */
+static void draw_noise(uint32_t seed){
+  uint8_t* fb = SSD1306_GetBuffer();
+  for (int i = 0; i < 1024; ++i){ seed = seed * 1103515245u + 12345u; fb[i] = (uint8_t)(seed >> 16); }
+  SSD1306_Update();
+}
+
+static void check_stepwise(void){
+  char whole[MAX_LINES][300];
+  int nwhole;
+
+  draw_noise(1);
+  s_nlines = 0;
+  int bytes = Snap_Send(collect, 1);
+  CHECK(bytes > 4 * SNAP_CHUNK_BYTES);               /* 远超 NB 队列一次能排下的 3 行 */
+  nwhole = s_nlines;
+  memcpy(whole, s_lines, sizeof(whole));
+  CHECK_EQ(Snap_Pending(), 0);
+
+  /* 逐行发：途中屏幕变了、有时排不下，结果与一次发完逐行相同 */
+  s_nlines = 0;
+  CHECK_EQ(Snap_Begin(1), bytes);
+  CHECK_EQ(Snap_Pending(), nwhole);
+  for (int k = 0; Snap_Pending(); ++k){
+    if (k == 1) draw_noise(2);
+    if (k % 3 == 0){
+      s_full = 1;
+      int before = Snap_Pending();
+      CHECK_EQ(Snap_SendNext(collect), -5);
+      CHECK_EQ(Snap_Pending(), before);
+    }
+    CHECK_EQ(Snap_SendNext(collect), Snap_Pending());
+  }
+  CHECK_EQ(Snap_SendNext(collect), 0);
+  CHECK_EQ(s_nlines, nwhole);
+  for (int i = 0; i < nwhole && i < s_nlines; ++i)
+    if (strcmp(whole[i], s_lines[i])){ fprintf(stderr, "第 %d 行与一次发完的不同\n", i + 1); Host_FailCount++; }
+
+  /* 发完了才换基准：画面没变的下一张是 D 帧（以噪点 1 为基准，屏上已是噪点 2） */
+  draw_noise(1);
+  s_nlines = 0;
+  CHECK(Snap_Send(collect, 0) > 0);
+  CHECK_EQ(snap_type(0), 'D');
+  CHECK_EQ(s_nlines, 1);                             /* 全同：只有跳过 */
+
+  /* 中途失败：剩下的行丢掉，下一张是关键帧 */
+  draw_noise(3);
+  Snap_Begin(0);
+  CHECK(Snap_Pending() > 2);
+  s_nlines = 0;
+  Snap_SendNext(collect);
+  Snap_Reset();
+  CHECK_EQ(Snap_Pending(), 0);
+  CHECK_EQ(Snap_SendNext(collect), 0);
+  s_nlines = 0;
+  CHECK(Snap_Send(collect, 0) > 0);
+  CHECK_EQ(snap_type(0), 'K');
+
+  /* 没发完又开始新的一张：也只能发关键帧 */
+  draw_noise(4);
+  Snap_Begin(0);
+  CHECK(Snap_Pending() > 2);
+  Snap_SendNext(collect);
+  s_nlines = 0;
+  Snap_Begin(0);
+  Snap_SendNext(collect);
+  CHECK_EQ(snap_type(0), 'K');
+  Snap_Reset();
+
+  /* 一次发完的路径里 sink 失败：返回 <0，不留待发的行 */
+  CHECK(Snap_Send(fail_sink, 0) < 0);
+  CHECK_EQ(Snap_Pending(), 0);
+}
+
+static int snap_start(void){
+  s_start = -1;
+  CHECK(Snap_Send(sink, 1) > 0);
+  return s_start;
+}
+
+int main(void){
+  MockOled_Reset();
+  SSD1306_Init();
+  CHECK_EQ(snap_start(), 0);
+
+  /* 刷新后：截屏的起始行与屏上一致 */
+  SSD1306_DrawString(0, 0, "line 0");
+  SSD1306_SetStartLine(16);
+  SSD1306_Update();
+  CHECK_EQ(snap_start(), 16);
+  CHECK_EQ(snap_start(), MockOled_StartLine());
+
+  /* 只 Set 没刷新：屏上还是 16，截屏也必须是 16 */
+  SSD1306_SetStartLine(32);
+  CHECK_EQ(SSD1306_GetStartLine(), 32);
+  CHECK_EQ(snap_start(), 16);
+  SSD1306_Update();
+  CHECK_EQ(snap_start(), 32);
+
+  /* 刷新途中再改：正在发的这一帧带的是 40，途中改的 48 属于下一帧 */
+  MockOled_SetAutoDma(0);
+  SSD1306_DrawString(0, 40, "scrolled");
+  SSD1306_SetStartLine(40);
+  SSD1306_UpdateAsync();
+  SSD1306_SetStartLine(48);
+  CHECK_EQ(snap_start(), 40);
+  while (SSD1306_IsBusy()) MockOled_DmaComplete();
+  CHECK_EQ(MockOled_StartLine(), 40);
+  CHECK_EQ(snap_start(), 40);
+  MockOled_SetAutoDma(1);
+  SSD1306_Update();
+  CHECK_EQ(MockOled_StartLine(), 48);
+  CHECK_EQ(snap_start(), 48);
+
+  /* 重新初始化回到 0 */
+  SSD1306_Init();
+  CHECK_EQ(snap_start(), 0);
+
+  check_stepwise();
+
+  CHECK_EQ(MockOled_GetStats()->errors, 0);
+  return Host_Failures() != 0;
+}
@@ -0,0 +1,136 @@
+/* 遥测打包的发送端：真实 telemetry.c + nb_iot.c 对着模拟串口，喂一串专挑边界值的采样，
+ * 把模组收到的 AT+QISENDEX 命令原样写进 <目录>/tlm_tx.log，期望的逐条记录写进 <目录>/tlm_expect.csv。
+ * 解码与比对在 tlm_roundtrip.py 里（用 tools/tlm_decode.py 解 tlm_tx.log）。
+ * 边界值：同一秒两条（Δt=0）、几天的间隔、zigzag 后 1/2 字节的分界（Δ=±63/64/-65）、
+ * VDD 0 与 65535、照度 0 与 20 亿（5 字节 varint）、有无温湿度/照度的各种组合、
+ * 按条数 / 字节数 / 时间三种封包方式，以及发送失败后的原样重发。
+ * 默认每包 6 条时总是条数先到；CMake 里另编一份 TLM_MAX_SAMPLES=16 的，专门走字节数封包。 */
+#include "telemetry.h"
+#include "host_test.h"
+#include "mock_uart.h"
+#include <stdlib.h>
+#include <string.h>
+
+static FILE*    s_csv;
+static uint32_t s_now;
+static unsigned s_rows, s_sends, s_fails;
+static const char* s_reply = "SEND OK";
+
+/* 把排进 AT 队列的命令发出去并应答；失败时等够重试间隔让它原样重发 */
+static void pump(void){
+  for (int guard = 0; guard < 8; ++guard){
+    Tlm_Poll(s_now);
+    NB_Poll();
+    if (!NB_AtPending()) return;
+    s_sends++;
+    MockUart_FeedStr(s_reply);
+    MockUart_FeedStr("\r\n");
+    NB_Poll();
+    CHECK_EQ(NB_AtPending(), 0);
+    if (strcmp(s_reply, "SEND OK")){
+      s_fails++;
+      s_reply = "SEND OK";                     /* 只失败一次 */
+      s_now += TLM_RETRY_MS;
+      Host_SetTick(s_now);
+    }
+  }
+}
+
+static void add(uint32_t dt_ms, uint16_t vdd, int dht, uint8_t temp, uint8_t humi, int has_lux, uint32_t lux){
+  Tlm_Sample_t s = { 0 };
+  s_now += dt_ms;
+  Host_SetTick(s_now);
+  s.t_ms = s_now;
+  s.vdd_mv = vdd;
+  s.flags = (uint8_t)((dht ? TLM_HAS_DHT : 0) | (has_lux ? TLM_HAS_LUX : 0));
+  s.temp = temp; s.humi = humi; s.lux = lux;
+  CHECK_EQ(Tlm_Add(&s), 0);
+  fprintf(s_csv, "%u,%u,", (unsigned)(s_now / 1000u), vdd);
+  if (dht) fprintf(s_csv, "%u,%u,", temp, humi); else fprintf(s_csv, ",,");
+  if (has_lux) fprintf(s_csv, "%u\n", (unsigned)lux); else fprintf(s_csv, "\n");
+  s_rows++;
+  pump();
+}
+
+int main(int argc, char** argv){
+  const char* dir = (argc > 1) ? argv[1] : ".";
+  char path[512];
+  snprintf(path, sizeof(path), "%s/tlm_expect.csv", dir);
+  s_csv = fopen(path, "w");
+  if (!s_csv){ perror(path); return 1; }
+
+  MockUart_Reset();
+  g_nb.inited = 1; g_nb.opened = 1;
+  s_now = 5000;
+
+  /* 1. 常见：10 秒一条、读数小幅变化，按条数封包 */
+  for (int i = 0; i < 8; ++i) add(10000, (uint16_t)(3300 + i % 3), 1, (uint8_t)(25 + i % 2), (uint8_t)(60 - i), 1, 120u + (unsigned)i * 7u);
+
+  /* 2. Δt=0、Δ 正好在 zigzag 一字节/两字节的分界 */
+  add(0,    3300, 1, 100, 50, 1, 1000);
+  add(0,    3363, 1, 163, 50, 1, 1063);          /* +63：1 字节 */
+  add(999,  3427, 1, 227, 50, 1, 1127);          /* +64：2 字节 */
+  add(1,    3363, 1, 163, 50, 1, 1063);          /* -64：1 字节 */
+  add(0,    3298, 1, 98,  50, 1, 998);           /* -65：2 字节 */
+  add(1000, 3298, 1, 98,  50, 1, 998);           /* 全 0 */
+
+  /* 3. 极值：VDD 0/65535、照度 0/20 亿、温湿度 0/255 */
+  add(1000, 0,     1, 0,   0,   1, 0);
+  add(1000, 65535, 1, 255, 255, 1, 2000000000u);
+  add(1000, 0,     1, 0,   0,   1, 0);
+  add(1000, 65535, 0, 0,   0,   1, 2000000000u);
+
+  /* 4. 标志组合：温湿度 / 照度时有时无，Δ 相对本包里上一次出现的值 */
+  add(10000, 3300, 0, 0,  0,  0, 0);
+  add(10000, 3301, 1, 24, 70, 0, 0);
+  add(10000, 3302, 0, 0,  0,  1, 450);
+  add(10000, 3303, 0, 0,  0,  0, 0);
+  add(10000, 3304, 1, 26, 68, 1, 470);
+  add(10000, 3305, 1, 27, 67, 0, 0);
+
+  /* 5. 间隔很长：几天（多字节 Δt），每条单独按时间封包 */
+  add(3u * 86400u * 1000u, 3290, 1, 20, 80, 1, 5);
+  s_now += TLM_MAX_AGE_MS; Host_SetTick(s_now); pump();
+  add(1000u * 1000u * 1000u, 3280, 0, 0, 0, 1, 6);
+  s_now += TLM_MAX_AGE_MS; Host_SetTick(s_now); pump();
+
+  /* 6. 大读数把包撑到字节上限（每包条数放宽时按字节数封包） */
+  for (int i = 0; i < 12; ++i)
+    add(1000, (uint16_t)((i & 1) ? 65535 : 0), 1, (uint8_t)((i & 1) ? 255 : 0), (uint8_t)((i & 1) ? 0 : 255), 1, (i & 1) ? 2000000000u : 0u);
+
+  /* 7. 发送失败：同一包原样重发（日志里出现两次，解码要去重） */
+  add(10000, 3300, 1, 25, 60, 1, 100);
+  s_reply = "SEND FAIL";
+  s_now += TLM_MAX_AGE_MS; Host_SetTick(s_now); pump();
+  add(10000, 3301, 1, 25, 61, 0, 0);
+  s_reply = "ERROR";
+  s_now += TLM_MAX_AGE_MS; Host_SetTick(s_now); pump();
+
+  /* 收尾：剩下的按时间封包发出 */
+  s_now += TLM_MAX_AGE_MS; Host_SetTick(s_now); pump();
+  fclose(s_csv);
+
+  CHECK_EQ(Tlm_Dropped(), 0);
+  CHECK_EQ(s_fails, 2);
+  CHECK(s_sends >= s_rows / TLM_MAX_SAMPLES + 2);   /* 至少按条数封的包 + 两次重发 */
+
+  /* 最长的一包：条数放宽时必须是被字节数上限截下来的 */
+  unsigned max_len = 0;
+  for (const char* p = MockUart_Tx(); (p = strstr(p, "QISENDEX=1,")) != NULL; ){
+    unsigned n = (unsigned)strtoul(p + 11, NULL, 10);
+    if (n > max_len) max_len = n;
+    p += 11;
+  }
+  CHECK(max_len <= TLM_MAX_BYTES);
+#if TLM_MAX_SAMPLES >= 12
+  CHECK(max_len > TLM_MAX_BYTES * 3 / 4);
+#endif
+
+  snprintf(path, sizeof(path), "%s/tlm_tx.log", dir);
+  FILE* f = fopen(path, "w");
+  if (!f){ perror(path); return 1; }
+  fwrite(MockUart_Tx(), 1, MockUart_TxLen(), f);
+  fclose(f);
+  printf("%u 条，%u 次发送（%u 次失败重发），最长一包 %u 字节\n", s_rows, s_sends, s_fails, max_len);
+  return Host_Failures() != 0;
+}
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""遥测往返测试：test_tlm 按真实固件打包发出 → tools/tlm_decode.py 解码 → 与期望逐条比对。
+
+  tlm_roundtrip.py <test_tlm 可执行文件> <tools/tlm_decode.py> <工作目录>
+
+除了原样的发送日志，还检查去重：每包重复、重复的包隔开好几包才出现、整体乱序，
+结果都必须与期望的记录集合相同；同一序号内容变了（设备重启）的包不能被当成重发丢掉。
+"""
+import os
+import random
+import subprocess
+import sys
+
+
+def run_decoder(decoder, text, workdir, name):
+    path = os.path.join(workdir, name)
+    with open(path, 'w', encoding='utf-8', newline='\n') as f:
+        f.write(text)
+    out = subprocess.run([sys.executable, decoder, path], check=True,
+                         stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+    lines = out.stdout.splitlines()
+    if not lines or lines[0] != 'seq,t_s,vdd_mv,temp_c,humi_pct,lux':
+        raise SystemExit('%s：CSV 表头不对：%r' % (name, lines[:1]))
+    if 'ValueError' in out.stderr or '跳过' in out.stderr:
+        raise SystemExit('%s：解码报错\n%s' % (name, out.stderr))
+    return [l.split(',', 1) for l in lines[1:]]       # (seq, 其余字段)
+
+
+def main():
+    exe, decoder, workdir = sys.argv[1:4]
+    os.makedirs(workdir, exist_ok=True)
+    subprocess.run([exe, workdir], check=True)
+    with open(os.path.join(workdir, 'tlm_expect.csv'), encoding='utf-8') as f:
+        expect = f.read().splitlines()
+    with open(os.path.join(workdir, 'tlm_tx.log'), encoding='utf-8') as f:
+        sends = [l for l in f.read().splitlines() if 'QISENDEX' in l]
+    fails = 0
+
+    def check(name, rows, ordered):
+        nonlocal fails
+        got = [r[1] for r in rows]
+        ok = (got == expect) if ordered else (sorted(got) == sorted(expect))
+        if not ok:
+            fails += 1
+            print('%s：解码结果与期望不符' % name, file=sys.stderr)
+            for a, b in zip(got, expect):
+                if a != b:
+                    print('  解出 %s\n  期望 %s' % (a, b), file=sys.stderr)
+                    break
+            print('  共 %d 条，期望 %d 条' % (len(got), len(expect)), file=sys.stderr)
+        return rows
+
+    # 1. 原样：逐条相同，序号从 1 起连续不减
+    rows = check('原样日志', run_decoder(decoder, '\n'.join(sends) + '\n', workdir, 'as_sent.log'), True)
+    seqs = [int(r[0]) for r in rows]
+    if seqs[0] != 1 or any(b - a not in (0, 1) for a, b in zip(seqs, seqs[1:])):
+        fails += 1
+        print('包序号不连续：%s' % seqs, file=sys.stderr)
+    if len(set(sends)) == len(sends):
+        fails += 1
+        print('发送日志里没有重发的包，去重没测到', file=sys.stderr)
+
+    # 2. 每包都重复，且重复的那一份隔开 3 包才出现
+    uniq = list(dict.fromkeys(sends))
+    spaced = []
+    for i, s in enumerate(uniq):
+        spaced.append(s)
+        if i >= 3:
+            spaced.append(uniq[i - 3])
+    spaced += uniq[-3:]
+    check('隔开的重发', run_decoder(decoder, '\n'.join(spaced) + '\n', workdir, 'spaced_dup.log'), False)
+
+    # 3. 整体乱序 + 重复
+    rnd = random.Random(1)
+    shuffled = uniq * 2
+    rnd.shuffle(shuffled)
+    check('乱序', run_decoder(decoder, '\n'.join(shuffled) + '\n', workdir, 'shuffled.log'), False)
+
+    # 4. 设备重启：序号从 1 重来但内容不同，不是重发，要解出来
+    reboot = bytes([1, 1, 7, 0, 0, 0xC8, 0x33])              # 序号 1、首条 7 s、一条 vdd=3300
+    text = '\n'.join(uniq) + '\nAT+QISENDEX=1,%d,%s\n' % (len(reboot), reboot.hex().upper())
+    rows = run_decoder(decoder, text, workdir, 'reboot.log')
+    if [r[1] for r in rows[:-1]] != expect or rows[-1] != ['1', '7,3300,,,']:
+        fails += 1
+        print('重启后的包被当成重发丢掉了：%s' % rows[-1:], file=sys.stderr)
+
+    print('%d 包 %d 条：%s' % (len(uniq), len(expect), '全部通过' if not fails else '%d 处失败' % fails))
+    return 1 if fails else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""大号数字字库编译器：字符画 → SSD1306 页格式位图 + 比例字宽表。
+
+每个字按页存放：第 0 页 w 个字节、第 1 页 w 个字节……（每字节一列 8 行，bit0 在上），
+运行时 BigFont_DrawText 每页一次 SSD1306_BlitColumns 写进帧缓冲，不逐点画。
+字符编码为 1 字节：ASCII 原样，“°” 记为 0xB0（UTF-8 的 C2 B0 去掉前导字节）。
+
+用法（仓库根目录，默认路径即可）：
+  tools/bigfont.py [--src tools/bigfont_src.txt]
+"""
+import argparse
+import os
+import sys
+
+
+def read_fonts(path):
+    fonts = []                                  # [(height, gap, {code: rows})]
+    cur = None
+    with open(path, encoding='utf-8') as f:
+        for ln, line in enumerate(f, 1):
+            line = line.rstrip('\r\n').rstrip()
+            if not line or line.startswith('#') and set(line) - set('#.'):
+                continue                        # 注释；全由 # 和 . 组成的是字符画
+            if line.startswith('@'):
+                parts = line[1:].split()
+                h, gap = int(parts[0]), int(parts[1]) if len(parts) > 1 else 1
+                if h % 8 or not 8 <= h <= 64:
+                    sys.exit('%s:%d: 高度 %d 须为 8 的倍数' % (path, ln, h))
+                fonts.append((h, gap, {}))
+                cur = None
+                continue
+            if line.startswith(':') and len(line) == 2:
+                if not fonts:
+                    sys.exit('%s:%d: 字前缺少 “@高度”' % (path, ln))
+                u = ord(line[1])
+                code = u if u < 0x80 else (0xB0 if u == 0xB0 else None)
+                if code is None:
+                    sys.exit('%s:%d: 只支持 ASCII 和 “°”' % (path, ln))
+                cur = []
+                fonts[-1][2][code] = cur
+                continue
+            if cur is None or set(line) - set('#.'):
+                sys.exit('%s:%d: 无法识别' % (path, ln))
+            if cur and len(line) != len(cur[0]):
+                sys.exit('%s:%d: 同一字每行应等宽' % (path, ln))
+            cur.append(line)
+    for h, _, glyphs in fonts:
+        for code, rows in glyphs.items():
+            if len(rows) != h:
+                sys.exit('%s: %d 号字 %r 有 %d 行，应为 %d' % (path, h, chr(code), len(rows), h))
+    return fonts
+
+
+def to_pages(rows):
+    h, w = len(rows), len(rows[0])
+    out = []
+    for p in range(h // 8):
+        for x in range(w):
+            b = 0
+            for r in range(8):
+                if rows[p * 8 + r][x] == '#':
+                    b |= 1 << r
+            out.append(b)
+    return out
+
+
+def main():
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('--src', default=os.path.join(root, 'tools', 'bigfont_src.txt'))
+    ap.add_argument('--out', default=os.path.join(root, 'Core', 'Src', 'bigfont_glyphs.inc'))
+    args = ap.parse_args()
+
+    fonts = read_fonts(args.src)
+    codes = sorted(fonts[0][2]) if fonts else []
+    for h, _, glyphs in fonts:
+        if sorted(glyphs) != codes:
+            sys.exit('bigfont: 各字号的字符集须相同（%d 号不同）' % h)
+    if len(codes) > 254:
+        sys.exit('bigfont: 字太多')
+
+    rel = os.path.relpath(args.src, root).replace(os.sep, '/')
+    total = 0
+    with open(args.out, 'w', encoding='utf-8', newline='\n') as f:
+        w = f.write
+        w('/* 由 tools/bigfont.py 从 %s 生成，勿手改 */\n\n' % rel)
+        w('#define BIGFONT_GLYPHS %d\n\n' % len(codes))
+        w('/* 字符编码 → 字序号，0xFF=没有这个字 */\n')
+        index = [0xFF] * 256
+        for i, c in enumerate(codes):
+            index[c] = i
+        w('static const uint8_t BIGFONT_INDEX[256] = {\n')
+        for i in range(0, 256, 16):
+            w('  %s,\n' % ','.join('0x%02X' % v for v in index[i:i + 16]))
+        w('};\n')
+        for h, gap, glyphs in fonts:
+            w('\n/* %d 行高：%s */\n' % (h, ''.join(chr(c) for c in codes)))
+            w('static const uint8_t BIGFONT%d_BMP[] = {\n' % h)
+            offs, off = [], 0
+            for c in codes:
+                data = to_pages(glyphs[c])
+                offs.append((off, len(glyphs[c][0])))
+                w('  /* %s */ %s,\n' % (chr(c), ','.join('0x%02X' % b for b in data)))
+                off += len(data)
+            w('};\n')
+            if off > 0xFFFF:
+                sys.exit('bigfont: %d 号字库超过 64KB' % h)
+            w('static const BigGlyph_t BIGFONT%d_GLYPHS[BIGFONT_GLYPHS] = {\n' % h)
+            for c, (o, gw) in zip(codes, offs):
+                w('  { %5d, %2d },   /* %s */\n' % (o, gw, chr(c)))
+            w('};\n')
+            total += off
+        w('\nstatic const BigFontDesc_t BIGFONTS[] = {\n')
+        for h, gap, _ in fonts:
+            w('  { BIGFONT%d_BMP, BIGFONT%d_GLYPHS, %d, %d },\n' % (h, h, h, gap))
+        w('};\n')
+
+    sys.stderr.write('bigfont: %d 个字号 × %d 个字，位图 %d 字节\n' % (len(fonts), len(codes), total))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""16x16 汉字点阵转换：行优先位图 / BDF → SSD1306 页格式（font16.c 用）。
+
+输入（可混合多个，后出现的同码点覆盖前面的）：
+  *.c / *.h / *.inc  C 源里的行优先 32 字节表，两种写法都认：
+                       /* “你” U+4F60 */ static const uint8_t G_4F60[32] = { ... };
+                       {0x4F60,{0x00,0x10, ...}},
+                     本工具自己生成的 font16_glyphs.inc（先解压转回行再合并）
+  *.bdf              16x16 点阵 BDF 字体（如 wenquanyi / unifont 的 16px 版本）
+
+输出：按码点排序的 FONT16_CODES[]，以及压缩字库 FONT16_OFFS[] + FONT16_Z[]。
+每字先转成页格式（前 16 字节是上半页第 0~7 行的 16 列，后 16 字节是下半页，
+bit0 在最上面，与 SSD1306 显存一致），再按 pack_glyph() 压缩；解码在 font16.c。
+
+用法：
+  tools/font16_convert.py Core/Src/font16_glyphs.inc new.c -o Core/Src/font16_glyphs.inc
+  tools/font16_convert.py wqy16.bdf --chars "温湿度光照" -o Core/Src/font16_glyphs.inc
+"""
+import argparse
+import re
+import sys
+
+HEX2 = re.compile(r'0x([0-9A-Fa-f]{1,2})\b')
+
+
+def rows_to_pages(rows):
+    """rows: 32 字节，每行 2 字节，高位在左 → 32 字节页格式"""
+    out = [0] * 32
+    for r in range(16):
+        bits = (rows[r * 2] << 8) | rows[r * 2 + 1]
+        for c in range(16):
+            if bits & (0x8000 >> c):
+                out[(r // 8) * 16 + c] |= 1 << (r & 7)
+    return out
+
+
+def pages_to_rows(pages):
+    out = [0] * 32
+    for p in range(2):
+        for c in range(16):
+            b = pages[p * 16 + c]
+            for bit in range(8):
+                if b & (1 << bit):
+                    r = p * 8 + bit
+                    out[r * 2 + (c >> 3)] |= 0x80 >> (c & 7)
+    return out
+
+
+def block_after(text, pos):
+    """从 pos 起找下一个 {...}，返回其中的内容（不跨越嵌套的外层）"""
+    i = text.find('{', pos)
+    if i < 0:
+        return None
+    depth, j = 0, i
+    while j < len(text):
+        if text[j] == '{':
+            depth += 1
+        elif text[j] == '}':
+            depth -= 1
+            if depth == 0:
+                return text[i + 1:j]
+        j += 1
+    return None
+
+
+def strip_comments(text):
+    return re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+
+
+def pack_glyph(pages):
+    """压缩一个页格式字形（格式见 font16.c）：
+    每半页内每列与左边一列异或（竖笔画、横笔画的中段都变成 0），
+    再编码成 token 流：token 高 4 位 = 连续 0 的个数，低 4 位 = 紧跟的原样字节个数。"""
+    d = []
+    for h in range(2):
+        prev = 0
+        for c in range(16):
+            b = pages[h * 16 + c]
+            d.append(b ^ prev)
+            prev = b
+    out, i = [], 0
+    while i < 32:
+        z = 0
+        while i < 32 and d[i] == 0 and z < 15:
+            z += 1
+            i += 1
+        lits = []
+        while i < 32 and d[i] != 0 and len(lits) < 15:
+            lits.append(d[i])
+            i += 1
+        out.append(z << 4 | len(lits))
+        out += lits
+    return out
+
+
+def unpack_glyph(z):
+    d, k = [], 0
+    while len(d) < 32:
+        t = z[k]
+        k += 1
+        d += [0] * (t >> 4)
+        d += z[k:k + (t & 15)]
+        k += t & 15
+    out = d[:32]
+    for h in range(2):
+        for c in range(1, 16):
+            out[h * 16 + c] ^= out[h * 16 + c - 1]
+    return out, k
+
+
+def parse_generated(text):
+    """本工具输出的表（压缩的 FONT16_Z，或早先未压缩的 FONT16_BMP）"""
+    glyphs = {}
+    body = strip_comments(text)
+    codes_blk = block_after(body, body.index('FONT16_CODES'))
+    codes = [int(x, 16) for x in re.findall(r'0x([0-9A-Fa-f]+)', codes_blk)]
+    if 'FONT16_Z' in body:
+        offs_blk = block_after(body, body.index('FONT16_OFFS'))
+        offs = [int(x) for x in re.findall(r'\b\d+\b', offs_blk)]
+        z = [int(x, 16) for x in HEX2.findall(block_after(body, body.index('FONT16_Z')))]
+        if len(offs) != len(codes) + 1 or offs[-1] != len(z):
+            sys.exit('font16_convert: FONT16_CODES/FONT16_OFFS/FONT16_Z 不一致')
+        for k, u in enumerate(codes):
+            pages, used = unpack_glyph(z[offs[k]:offs[k + 1]])
+            if used != offs[k + 1] - offs[k]:
+                sys.exit('font16_convert: U+%04X 压缩数据损坏' % u)
+            glyphs[u] = pages_to_rows(pages)
+        return glyphs
+    vals = [int(x, 16) for x in HEX2.findall(block_after(body, body.index('FONT16_BMP')))]
+    if len(vals) != 32 * len(codes):
+        sys.exit('font16_convert: FONT16_CODES/FONT16_BMP 长度不一致')
+    for k, u in enumerate(codes):
+        glyphs[u] = pages_to_rows(vals[k * 32:(k + 1) * 32])
+    return glyphs
+
+
+def parse_c_rows(text):
+    """行优先 C 表：码点后面紧跟（或下一个花括号里）正好 32 个字节的才算一个字"""
+    if 'font16_convert.py' in text and 'FONT16_CODES' in text:
+        return parse_generated(text)
+    glyphs = {}
+    for m in re.finditer(r'(?:U\+|\{\s*0x)([0-9A-Fa-f]{4,5})', text):
+        blk = block_after(text, m.end())
+        if blk is None:
+            continue
+        vals = [int(x, 16) for x in HEX2.findall(strip_comments(blk))]
+        if len(vals) == 32 and not re.search(r'0x[0-9A-Fa-f]{3,}', blk):
+            glyphs[int(m.group(1), 16)] = vals
+    return glyphs
+
+
+def parse_bdf(text):
+    glyphs = {}
+    fbb = re.search(r'^FONTBOUNDINGBOX\s+(-?\d+)\s+(-?\d+)\s+(-?\d+)\s+(-?\d+)', text, re.M)
+    asc = re.search(r'^FONT_ASCENT\s+(\d+)', text, re.M)
+    if fbb:
+        base = int(fbb.group(2)) + int(fbb.group(4))   # 基线到单元顶部的行数
+    else:
+        base = 14
+    if asc:
+        base = int(asc.group(1))
+    for ch in re.finditer(r'STARTCHAR.*?ENDCHAR', text, re.S):
+        blk = ch.group(0)
+        enc = re.search(r'^ENCODING\s+(-?\d+)', blk, re.M)
+        bbx = re.search(r'^BBX\s+(-?\d+)\s+(-?\d+)\s+(-?\d+)\s+(-?\d+)', blk, re.M)
+        bm = re.search(r'^BITMAP\s*\n(.*?)\nENDCHAR', blk, re.M | re.S)
+        if not (enc and bbx and bm) or int(enc.group(1)) < 0:
+            continue
+        w, h, xo, yo = (int(v) for v in bbx.groups())
+        if w > 16 or h > 16:
+            continue
+        rows = [0] * 32
+        top = base - (h + yo)
+        for i, line in enumerate(bm.group(1).split()):
+            r = top + i
+            if not 0 <= r < 16:
+                continue
+            bits = int(line, 16) << (16 - len(line) * 4) if len(line) * 4 <= 16 else int(line, 16) >> (len(line) * 4 - 16)
+            bits = (bits >> xo) & 0xFFFF if xo >= 0 else (bits << -xo) & 0xFFFF
+            rows[r * 2] |= bits >> 8
+            rows[r * 2 + 1] |= bits & 0xFF
+        glyphs[int(enc.group(1))] = rows
+    return glyphs
+
+
+def load(path):
+    with open(path, encoding='utf-8', errors='replace') as f:
+        text = f.read()
+    if path.lower().endswith('.bdf'):
+        return parse_bdf(text)
+    return parse_c_rows(text)
+
+
+def emit(glyphs, out):
+    codes = sorted(u for u in glyphs if u <= 0xFFFF)
+    packed = [pack_glyph(rows_to_pages(glyphs[u])) for u in codes]
+    total = sum(len(z) for z in packed)
+    if total > 0xFFFF:
+        sys.exit('font16_convert: 压缩后 %d 字节，超出 16 位偏移范围' % total)
+
+    w = out.write
+    w('/* 由 tools/font16_convert.py 生成，勿手改；追加字形请用工具合并后重新生成。\n')
+    w(' * %d 字，压缩后 %d 字节（未压缩 %d 字节），格式见 font16.c。 */\n\n'
+      % (len(codes), total, 32 * len(codes)))
+    w('static const uint16_t FONT16_CODES[] = {\n')
+    for u in codes:
+        w('  0x%04X, /* %s */\n' % (u, chr(u)))
+    w('};\n\n')
+    w('/* 第 i 个字的压缩数据为 FONT16_Z[FONT16_OFFS[i] .. FONT16_OFFS[i+1]) */\n')
+    w('static const uint16_t FONT16_OFFS[] = {\n')
+    off = 0
+    for z in packed:
+        w('  %d,\n' % off)
+        off += len(z)
+    w('  %d\n};\n\n' % off)
+    w('static const uint8_t FONT16_Z[] = {\n')
+    for u, z in zip(codes, packed):
+        w('  /* “%s” U+%04X */ ' % (chr(u), u) + ','.join('0x%02X' % b for b in z) + ',\n')
+    w('};\n')
+    return len(codes), total
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('inputs', nargs='+', help='C 表 / 生成的 .inc / BDF')
+    ap.add_argument('--chars', help='只保留这些字（UTF-8 文本）')
+    ap.add_argument('--chars-file', help='只保留该文件里出现的字')
+    ap.add_argument('-o', '--output', help='输出文件（默认 stdout）')
+    args = ap.parse_args()
+
+    glyphs = {}
+    for path in args.inputs:
+        glyphs.update(load(path))
+
+    keep = None
+    if args.chars or args.chars_file:
+        keep = set(args.chars or '')
+        if args.chars_file:
+            with open(args.chars_file, encoding='utf-8') as f:
+                keep |= set(f.read())
+        keep = {ord(c) for c in keep if ord(c) >= 0x80}
+        missing = sorted(keep - set(glyphs))
+        if missing:
+            sys.stderr.write('font16_convert: 字库里没有：%s\n' % ''.join(chr(u) for u in missing))
+        glyphs = {u: g for u, g in glyphs.items() if u in keep}
+
+    if args.output:
+        with open(args.output, 'w', encoding='utf-8', newline='\n') as f:
+            n, total = emit(glyphs, f)
+    else:
+        n, total = emit(glyphs, sys.stdout)
+    raw = 32 * n
+    sys.stderr.write('font16_convert: %d glyphs, %d -> %d bytes (+%d index) = %.1f%%\n'
+                     % (n, raw, total, 4 * n + 2, 100.0 * (total + 4 * n + 2) / max(1, raw + 2 * n)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,61 @@
+/* 16x16 汉字源字库（行优先，高位在左；每行 2 字节，共 16 行 32 字节）。
+ * 这个文件不参与编译，是 tools/ui_strings.py / tools/font16_convert.py 的输入：
+ * 固件里的 Core/Src/font16_glyphs.inc 只含界面实际用到的字，由工具从这里（或 BDF 字库）子集化生成。
+ * 追加字形：用点阵工具导出 32 字节，按下面的格式贴进来（注释里的 U+XXXX 必须有）。 */
+
+/* “中” U+4E2D */
+{
+  0x00,0x00, 0x01,0x00, 0x01,0x00, 0x7F,0xFE,
+  0x41,0x02, 0x41,0x02, 0x41,0x02, 0x7F,0xFE,
+  0x41,0x02, 0x41,0x02, 0x41,0x02, 0x7F,0xFE,
+  0x01,0x00, 0x01,0x00, 0x00,0x00, 0x00,0x00
+},
+/* “你” U+4F60 */
+{
+  0x00,0x10, 0x00,0x10, 0x7F,0xFE, 0x00,0x10,
+  0x00,0x10, 0x1F,0xF0, 0x00,0x20, 0x00,0x40,
+  0x7F,0xFE, 0x00,0x80, 0x01,0x00, 0x06,0x00,
+  0x18,0x00, 0x60,0x00, 0x01,0x80, 0x00,0x60
+},
+/* “好” U+597D */
+{
+  0x00,0x08, 0x3F,0xFC, 0x20,0x08, 0x20,0x08,
+  0x3F,0xF8, 0x20,0x08, 0x20,0x08, 0x3F,0xF8,
+  0x04,0x00, 0x04,0x00, 0x24,0x00, 0x24,0x00,
+  0x44,0x00, 0x84,0x00, 0x04,0x00, 0x04,0x00
+},
+/* “文” U+6587 */
+{
+  0x00,0x00, 0x00,0x80, 0x40,0x80, 0x20,0x80,
+  0x10,0x80, 0x0F,0xFE, 0x00,0x80, 0x01,0x80,
+  0x02,0x80, 0x0C,0x80, 0x30,0x80, 0xC0,0x80,
+  0x00,0x80, 0x00,0x80, 0x00,0x80, 0x00,0x00
+},
+/* “温” U+6E29 */
+{
+  0x00,0x00, 0x00,0x20, 0x7F,0xFE, 0x02,0x20,
+  0x12,0x20, 0x0A,0x20, 0x7F,0xFE, 0x02,0x20,
+  0x12,0x20, 0x0A,0x20, 0x7F,0xFE, 0x00,0x00,
+  0x1F,0xF8, 0x10,0x08, 0x1F,0xF8, 0x10,0x08
+},
+/* “湿” U+6E7F */
+{
+  0x00,0x20, 0x7F,0xFE, 0x02,0x20, 0x02,0x20,
+  0x3F,0xF0, 0x22,0x10, 0x3F,0xF0, 0x22,0x10,
+  0x3F,0xF0, 0x00,0x00, 0x1F,0xF8, 0x10,0x08,
+  0x1F,0xF8, 0x10,0x08, 0x1F,0xF8, 0x10,0x08
+},
+/* “牙” U+7259 */
+{
+  0x00,0x00, 0x7F,0xFE, 0x01,0x00, 0x01,0x00,
+  0x3F,0xFC, 0x21,0x04, 0x21,0x04, 0x3F,0xFC,
+  0x01,0x00, 0x01,0x00, 0x7F,0xFE, 0x00,0x00,
+  0x00,0x00, 0x00,0x00, 0x00,0x00, 0x00,0x00
+},
+/* “蓝” U+84DD */
+{
+  0x00,0x40, 0x7F,0xFE, 0x04,0x40, 0x04,0x40,
+  0x3F,0xF8, 0x24,0x48, 0x3F,0xF8, 0x24,0x48,
+  0x3F,0xF8, 0x00,0x00, 0x7F,0xFE, 0x01,0x00,
+  0x11,0x10, 0x0E,0xE0, 0x00,0x00, 0x00,0x00
+},
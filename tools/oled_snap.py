@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""OLED 远程截屏解码：从串口/服务器日志里挑出 FB 行，还原成 PBM 或 PNG。
+
+设备收到含 “SNAP” 的行（NB 下行或串口）后发回若干行
+  FB,<序号>,<K|D>,<块号>/<块数>,<起始行>,<CRC16>,<base64>
+格式和压缩令牌见 Core/Inc/oled_snap.h。D 帧以上一个序号的画面为基准，
+所以日志要按收到的顺序整份喂进来；中间丢了帧会 CRC 不符，让设备发 “SNAP K” 即可。
+
+用法：
+  tools/oled_snap.py log.txt [-o snap_%03d.png] [--scale 4]
+  cat log.txt | tools/oled_snap.py -o last.pbm      # 不带 %d 时只留最后一张
+"""
+import argparse
+import base64
+import re
+import struct
+import sys
+import zlib
+
+W, H = 128, 64
+FB_BYTES = W * H // 8
+
+LINE_RE = re.compile(r'FB,(\d+),([KD]),(\d+)/(\d+),(\d+),([0-9A-Fa-f]{4}),([A-Za-z0-9+/=]*)')
+
+
+def crc16_ccitt(data):
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def decode(stream, ref):
+    """按令牌把压缩流还原成 1024 字节页格式显存；ref 是基准帧（关键帧为全 0）"""
+    out = bytearray()
+    i = 0
+    while i < len(stream):
+        t = stream[i]
+        i += 1
+        if t < 0x40:
+            n = t + 1
+            out += ref[len(out):len(out) + n]
+        elif t < 0x80:
+            n = t - 0x40 + 1
+            out += stream[i:i + n]
+            i += n
+        else:
+            n = ((t >> 2) & 0x1F) + 3
+            off = (((t & 3) << 8) | stream[i]) + 1
+            i += 1
+            if off > len(out):
+                raise ValueError('复制偏移越界')
+            for _ in range(n):                      # 可能与目标重叠，逐字节复制
+                out.append(out[-off])
+    if len(out) != FB_BYTES:
+        raise ValueError('长度 %d，应为 %d' % (len(out), FB_BYTES))
+    return bytes(out)
+
+
+def to_rows(fb, start):
+    """页格式 → 逐行像素（1=亮）；按起始行旋转成屏上看到的样子"""
+    rows = []
+    for y in range(H):
+        gy = (y + start) % H
+        page, bit = gy // 8, gy % 8
+        rows.append([(fb[page * W + x] >> bit) & 1 for x in range(W)])
+    return rows
+
+
+def scale_rows(rows, k):
+    return [[v for v in r for _ in range(k)] for r in rows for _ in range(k)]
+
+
+def write_pbm(path, rows):
+    w = len(rows[0])
+    with open(path, 'wb') as f:
+        f.write(b'P4\n%d %d\n' % (w, len(rows)))
+        for r in rows:
+            bits = r + [0] * (-w % 8)
+            f.write(bytes(int(''.join(str(b) for b in bits[i:i + 8]), 2) for i in range(0, len(bits), 8)))
+
+
+def write_png(path, rows):
+    """8 位灰度 PNG：亮点白、灭点黑，和屏上一致"""
+    w, h = len(rows[0]), len(rows)
+    raw = b''.join(b'\x00' + bytes(255 if v else 0 for v in r) for r in rows)
+
+    def chunk(tag, data):
+        c = struct.pack('>I', len(data)) + tag + data
+        return c + struct.pack('>I', zlib.crc32(tag + data) & 0xFFFFFFFF)
+
+    with open(path, 'wb') as f:
+        f.write(b'\x89PNG\r\n\x1a\n')
+        f.write(chunk(b'IHDR', struct.pack('>IIBBBBB', w, h, 8, 0, 0, 0, 0)))
+        f.write(chunk(b'IDAT', zlib.compress(raw, 9)))
+        f.write(chunk(b'IEND', b''))
+
+
+def frames(lines):
+    """逐行扫日志，每拼齐一张就 yield (序号, 类型, 压缩字节数, 显存, 起始行)"""
+    prev = None                                     # (序号, 显存)
+    cur = None                                      # 正在拼的一张：[seq, type, cnt, start, crc, {块号: 数据}]
+    for line in lines:
+        m = LINE_RE.search(line)
+        if not m:
+            continue
+        seq, typ, idx, cnt, start, crc, b64 = m.groups()
+        seq, idx, cnt, start, crc = int(seq), int(idx), int(cnt), int(start), int(crc, 16)
+        if cur is None or cur[0] != seq:
+            cur = [seq, typ, cnt, start, crc, {}]
+        cur[5][idx] = base64.b64decode(b64)
+        if len(cur[5]) < cnt:
+            continue
+        stream = b''.join(cur[5][i] for i in range(1, cnt + 1))
+        cur = None
+        if typ == 'K':
+            ref = bytes(FB_BYTES)
+        elif prev and prev[0] == (seq - 1) & 0xFF:
+            ref = prev[1]
+        else:
+            print('#%d: D 帧缺少基准（上一张没收到），跳过' % seq, file=sys.stderr)
+            prev = None
+            continue
+        try:
+            fb = decode(stream, ref)
+        except (ValueError, IndexError) as e:
+            print('#%d: 解码失败：%s' % (seq, e), file=sys.stderr)
+            prev = None
+            continue
+        if crc16_ccitt(fb) != crc:
+            print('#%d: CRC 不符，跳过' % seq, file=sys.stderr)
+            prev = None
+            continue
+        prev = (seq, fb)
+        yield seq, typ, len(stream), fb, start
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('log', nargs='*', help='日志文件（缺省读标准输入）')
+    ap.add_argument('-o', '--out', default='snap_%03d.png',
+                    help='输出文件名，.pbm 或 .png；含 %%d 时按序号每张一个文件')
+    ap.add_argument('--scale', type=int, default=1, help='放大倍数（看图方便）')
+    args = ap.parse_args()
+
+    if args.log:
+        lines = []
+        for p in args.log:
+            with open(p, encoding='utf-8', errors='replace') as f:
+                lines += f.readlines()
+    else:
+        lines = sys.stdin
+
+    n = 0
+    for seq, typ, size, fb, start in frames(lines):
+        path = args.out % seq if '%' in args.out else args.out
+        rows = to_rows(fb, start)
+        if args.scale > 1:
+            rows = scale_rows(rows, args.scale)
+        (write_pbm if path.lower().endswith('.pbm') else write_png)(path, rows)
+        print('#%d %s %d 字节 -> %s' % (seq, typ, size, path))
+        n += 1
+    if not n:
+        sys.exit('没有找到完整的截屏')
+
+
+if __name__ == '__main__':
+    main()
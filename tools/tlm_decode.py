@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""遥测包解码：把设备发来的二进制 UDP 包还原成逐条记录（CSV）。
+
+包格式见 Core/Inc/telemetry.h。输入可以是：
+  - 日志/文本：每行里找一段十六进制（如 AT+QISENDEX 命令或服务器按 hex 记下的包），一行一包
+  - --raw：每个文件就是一个原始 UDP 包
+
+用法：
+  tools/tlm_decode.py server.log > tlm.csv
+  tools/tlm_decode.py --raw pkt1.bin pkt2.bin
+  echo 010100... | tools/tlm_decode.py
+"""
+import argparse
+import re
+import sys
+
+FMT_VERSION = 1
+HAS_DHT = 0x01
+HAS_LUX = 0x02
+
+SENDEX_RE = re.compile(r'QISENDEX=\d+,\d+,([0-9A-Fa-f]+)')
+HEX_RE = re.compile(r'\b(?:[0-9A-Fa-f]{2}){3,}\b')
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.i = 0
+
+    def byte(self):
+        if self.i >= len(self.data):
+            raise ValueError('包被截断')
+        b = self.data[self.i]
+        self.i += 1
+        return b
+
+    def uv(self):
+        v, shift = 0, 0
+        while True:
+            b = self.byte()
+            v |= (b & 0x7F) << shift
+            if not b & 0x80:
+                return v
+            shift += 7
+            if shift > 35:
+                raise ValueError('varint 过长')
+
+    def sv(self):
+        v = self.uv()
+        return (v >> 1) ^ -(v & 1)
+
+    def done(self):
+        return self.i >= len(self.data)
+
+
+def decode(pkt):
+    """返回 (包序号, [(时刻 s, vdd, 温度|None, 湿度|None, 照度|None), ...])"""
+    r = Reader(pkt)
+    ver = r.byte()
+    if ver != FMT_VERSION:
+        raise ValueError('不认识的版本 %d' % ver)
+    seq = r.uv()
+    t = r.uv()
+    prev = {'vdd': 0, 'temp': 0, 'humi': 0, 'lux': 0}
+    recs = []
+    while not r.done():
+        flags = r.byte()
+        if flags & ~(HAS_DHT | HAS_LUX):
+            raise ValueError('未知标志位 0x%02X' % flags)
+        t += r.uv()
+        prev['vdd'] += r.sv()
+        temp = humi = lux = None
+        if flags & HAS_DHT:
+            prev['temp'] += r.sv()
+            prev['humi'] += r.sv()
+            temp, humi = prev['temp'], prev['humi']
+        if flags & HAS_LUX:
+            prev['lux'] += r.sv()
+            lux = prev['lux']
+        recs.append((t, prev['vdd'], temp, humi, lux))
+    return seq, recs
+
+
+def packets(args):
+    if args.raw:
+        for p in args.input:
+            with open(p, 'rb') as f:
+                yield f.read()
+        return
+    files = [open(p, encoding='utf-8', errors='replace') for p in args.input] or [sys.stdin]
+    for f in files:
+        for line in f:
+            m = SENDEX_RE.search(line)
+            if m:
+                yield bytes.fromhex(m.group(1))
+                continue
+            runs = HEX_RE.findall(line)                  # 没有命令头时取最长的一段
+            if runs:
+                yield bytes.fromhex(max(runs, key=len))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('input', nargs='*', help='日志或包文件（缺省读标准输入）')
+    ap.add_argument('--raw', action='store_true', help='输入文件是原始二进制包')
+    args = ap.parse_args()
+
+    # 去重按包序号：设备重发的包序号和内容都不变，但服务器日志里不一定紧挨着（中间可能夹着别的包、
+    # UDP 也会乱序）。同一序号内容却不同，说明设备重启或序号回绕了，之前记下的序号全部作废。
+    seen = {}
+    print('seq,t_s,vdd_mv,temp_c,humi_pct,lux')
+    for pkt in packets(args):
+        try:
+            seq, recs = decode(pkt)
+        except ValueError as e:
+            print('# 跳过一包（%d 字节）：%s' % (len(pkt), e), file=sys.stderr)
+            continue
+        if seen.get(seq) == pkt:                     # 重发
+            continue
+        if seq in seen:
+            print('# #%d 内容变了：设备重启或序号回绕，重新开始去重' % seq, file=sys.stderr)
+            seen.clear()
+        seen[seq] = pkt
+        for t, vdd, temp, humi, lux in recs:
+            print(','.join('' if v is None else str(v) for v in (seq, t, vdd, temp, humi, lux)))
+        print('# #%d: %d 条 %d 字节' % (seq, len(recs), len(pkt)), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
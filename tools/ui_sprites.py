@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""状态栏图标编译器：字符画 → 8 行高的竖排列位图（每列 1 字节，bit0 在上）。
+
+每帧就是 SSD1306 显存一页里的一段列，运行时 UI_SPRITE 控件换帧只需
+SSD1306_BlitColumns 把 w 个字节写进帧缓冲，不再逐点画线。
+
+用法（仓库根目录，默认路径即可）：
+  tools/ui_sprites.py [--src tools/ui_sprites.txt]
+"""
+import argparse
+import os
+import re
+import sys
+
+ROWS = 8
+
+
+def read_sprites(path):
+    sprites = []                                # [(name, width, [rows...])]
+    with open(path, encoding='utf-8') as f:
+        for ln, line in enumerate(f, 1):
+            line = line.rstrip('\r\n').rstrip()
+            if not line or line.startswith('#') and not set(line) <= set('#.'):
+                continue
+            if line.startswith('@'):
+                name = line[1:].strip().upper()
+                if not re.match(r'^[A-Z_][A-Z0-9_]*$', name):
+                    sys.exit('%s:%d: 图标名 %s 不合法' % (path, ln, name))
+                if any(name == n for n, _, _ in sprites):
+                    sys.exit('%s:%d: 图标 %s 重复' % (path, ln, name))
+                sprites.append((name, 0, []))
+                continue
+            if not sprites:
+                sys.exit('%s:%d: 字符画前缺少 “@名字”' % (path, ln))
+            if set(line) - set('#.'):
+                sys.exit('%s:%d: 只能用 # 和 .' % (path, ln))
+            name, width, rows = sprites[-1]
+            if width and len(line) != width:
+                sys.exit('%s:%d: %s 每行应为 %d 列' % (path, ln, name, width))
+            rows.append(line)
+            sprites[-1] = (name, len(line), rows)
+    for name, width, rows in sprites:
+        if not rows or len(rows) % ROWS:
+            sys.exit('%s: %s 的行数 %d 不是 %d 的倍数' % (path, name, len(rows), ROWS))
+        if width > 255 or len(rows) // ROWS > 255:
+            sys.exit('%s: %s 太大' % (path, name))
+    return sprites
+
+
+def to_columns(rows, width):
+    out = []
+    for f in range(0, len(rows), ROWS):
+        for x in range(width):
+            b = 0
+            for r in range(ROWS):
+                if rows[f + r][x] == '#':
+                    b |= 1 << r
+            out.append(b)
+    return out
+
+
+def main():
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('--src', default=os.path.join(root, 'tools', 'ui_sprites.txt'))
+    ap.add_argument('--out-h', default=os.path.join(root, 'Core', 'Inc', 'ui_sprites.h'))
+    ap.add_argument('--out-inc', default=os.path.join(root, 'Core', 'Src', 'ui_sprites.inc'))
+    args = ap.parse_args()
+
+    sprites = read_sprites(args.src)
+    rel = os.path.relpath(args.src, root).replace(os.sep, '/')
+
+    with open(args.out_h, 'w', encoding='utf-8', newline='\n') as f:
+        w = f.write
+        w('/* 由 tools/ui_sprites.py 从 %s 生成，勿手改 */\n' % rel)
+        w('#ifndef UI_SPRITES_H\n#define UI_SPRITES_H\n\n#include "ui_widget.h"\n\n')
+        for name, width, rows in sprites:
+            w('#define UI_SPR_%s_W %d\n' % (name, width))
+            w('#define UI_SPR_%s_N %d\n' % (name, len(rows) // ROWS))
+            w('extern const UI_Sprite_t UI_SPR_%s;\n\n' % name)
+        w('#endif\n')
+
+    total = 0
+    with open(args.out_inc, 'w', encoding='utf-8', newline='\n') as f:
+        w = f.write
+        w('/* 由 tools/ui_sprites.py 从 %s 生成，勿手改 */\n' % rel)
+        for name, width, rows in sprites:
+            cols = to_columns(rows, width)
+            total += len(cols)
+            w('\nstatic const uint8_t UI_SPR_%s_COLS[] = {\n' % name)
+            for i in range(0, len(cols), width):
+                w('  %s,\n' % ','.join('0x%02X' % b for b in cols[i:i + width]))
+            w('};\n')
+            w('const UI_Sprite_t UI_SPR_%s = { %d, %d, UI_SPR_%s_COLS };\n'
+              % (name, width, len(rows) // ROWS, name))
+
+    sys.stderr.write('ui_sprites: %d 个图标，%d 字节\n' % (len(sprites), total))
+
+
+if __name__ == '__main__':
+    main()
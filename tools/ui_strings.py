@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""界面字符串编译器：UI 字符串表 → 预解码字形序列 + 子集化 16x16 字库。
+
+运行时（ssd1306_utf8.c 里的 OLED_DrawText 一族）直接按字形序列画，不再做 UTF-8 解码，
+整行宽度和两行拆分点在这里算好。字库只保留字符串表里出现的汉字。
+
+字形序列每项 1 字节：
+  0x20~0x7E  ASCII，按 6x8 字体画（其余 ASCII 控制符按 '?'）
+  0x80+k     字库（子集）里第 k 个汉字，16x16，k < 127
+  0xFF       字库里没有的字，画“□”
+
+用法（仓库根目录，默认路径即可）：
+  tools/ui_strings.py [--catalog tools/ui_strings.txt] [--font tools/font16_src.c ...]
+生成的三个文件必须一起提交：汉字序号依赖同一次生成的字库顺序。
+"""
+import argparse
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import font16_convert  # noqa: E402
+
+SCREEN_W = 128
+ASCII_W = 6
+CJK_W = 16
+BOX = 0xFF
+MAX_CJK = 0x7F
+
+
+def read_catalog(path):
+    items = []
+    with open(path, encoding='utf-8') as f:
+        for ln, line in enumerate(f, 1):
+            line = line.rstrip('\r\n')
+            if not line.strip() or line.lstrip().startswith('#'):
+                continue
+            m = re.match(r'\s*([A-Za-z_][A-Za-z0-9_]*)\s+(.*)$', line)
+            if not m:
+                sys.exit('%s:%d: 格式应为 “ID 文本”' % (path, ln))
+            sid, text = m.group(1).upper(), m.group(2).rstrip()
+            if len(text) >= 2 and text[0] == text[-1] == '"':
+                text = text[1:-1]
+            if any(sid == s for s, _ in items):
+                sys.exit('%s:%d: ID %s 重复' % (path, ln, sid))
+            items.append((sid, text))
+    return items
+
+
+def main():
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('--catalog', default=os.path.join(root, 'tools', 'ui_strings.txt'))
+    ap.add_argument('--font', action='append',
+                    help='源字库（行优先 C 表 / BDF / 生成的 .inc），可多次给；默认 tools/font16_src.c')
+    ap.add_argument('--out-h', default=os.path.join(root, 'Core', 'Inc', 'ui_strings.h'))
+    ap.add_argument('--out-inc', default=os.path.join(root, 'Core', 'Src', 'ui_strings.inc'))
+    ap.add_argument('--out-font', default=os.path.join(root, 'Core', 'Src', 'font16_glyphs.inc'))
+    args = ap.parse_args()
+
+    items = read_catalog(args.catalog)
+    fonts = args.font or [os.path.join(root, 'tools', 'font16_src.c')]
+    master = {}
+    for path in fonts:
+        master.update(font16_convert.load(path))
+
+    used = sorted({ord(c) for _, t in items for c in t if ord(c) >= 0x80 and ord(c) in master})
+    missing = sorted({c for _, t in items for c in t if ord(c) >= 0x80 and ord(c) not in master})
+    if missing:
+        sys.stderr.write('ui_strings: 字库里没有，显示为“□”：%s\n' % ''.join(missing))
+    if len(used) > MAX_CJK:
+        sys.exit('ui_strings: 用到 %d 个汉字，超过单字节编码上限 %d' % (len(used), MAX_CJK))
+    index = {u: k for k, u in enumerate(used)}
+
+    # 字库子集（FONT16_CODES 排序与 index 一致）
+    with open(args.out_font, 'w', encoding='utf-8', newline='\n') as f:
+        n, total = font16_convert.emit({u: master[u] for u in used}, f)
+
+    enc = []
+    for sid, text in items:
+        seq, widths = [], []
+        for c in text:
+            u = ord(c)
+            if u < 0x80:
+                seq.append(u if 0x20 <= u <= 0x7E else ord('?'))
+                widths.append(ASCII_W)
+            else:
+                seq.append(0x80 + index[u] if u in index else BOX)
+                widths.append(CJK_W)
+        # 两行拆分：第一行放得下的最多字数（与 OLED_UTF8_SplitTwoLines 相同的贪心规则）
+        w, brk = 0, 0
+        while brk < len(widths) and w + widths[brk] <= SCREEN_W:
+            w += widths[brk]
+            brk += 1
+        if len(seq) > 255 or sum(widths) > 0xFFFF:
+            sys.exit('ui_strings: %s 太长' % sid)
+        enc.append((sid, text, seq, sum(widths), brk))
+
+    rel = os.path.relpath(args.catalog, root).replace(os.sep, '/')
+    with open(args.out_h, 'w', encoding='utf-8', newline='\n') as f:
+        w = f.write
+        w('/* 由 tools/ui_strings.py 从 %s 生成，勿手改 */\n' % rel)
+        w('#ifndef UI_STRINGS_H\n#define UI_STRINGS_H\n\n')
+        w('typedef enum {\n')
+        for sid, text, _, _, _ in enc:
+            w('  UI_STR_%s,%s/* %s */\n' % (sid, ' ' * max(1, 20 - len(sid)), text))
+        w('  UI_STR_COUNT\n} UiStr_t;\n\n#endif\n')
+
+    with open(args.out_inc, 'w', encoding='utf-8', newline='\n') as f:
+        w = f.write
+        w('/* 由 tools/ui_strings.py 从 %s 生成，勿手改；汉字序号对应同一次生成的 font16_glyphs.inc */\n\n' % rel)
+        for sid, text, seq, _, _ in enc:
+            w('static const uint8_t UI_G_%s[] = { %s }; /* %s */\n'
+              % (sid, ','.join('0x%02X' % b for b in seq) or '0', text))
+        w('\nstatic const UiText_t UI_TEXTS[UI_STR_COUNT] = {\n')
+        for sid, _, seq, width, brk in enc:
+            w('  [UI_STR_%s] = { UI_G_%s, %d, %d, %d },\n' % (sid, sid, len(seq), width, brk))
+        w('};\n')
+
+    sys.stderr.write('ui_strings: %d 条字符串，%d 个汉字（源字库 %d 个），字库 %d 字节\n'
+                     % (len(enc), n, len(master), total + 4 * n + 2))
+
+
+if __name__ == '__main__':
+    main()